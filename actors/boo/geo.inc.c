@@ -4,12 +4,16 @@ const GeoLayout boo_geo[] = {
    GEO_OPEN_NODE(),
       GEO_SCALE(0x00, 26214),
       GEO_OPEN_NODE(),
+#ifdef TRANSPARENT_OBJECT_BATCHING
+         GEO_ASM(0, geo_boo_append_batch_instance),
+#else
          GEO_ASM(GEO_TRANSPARENCY_MODE_NORMAL, geo_update_layer_transparency),
          GEO_SWITCH_CASE(2, geo_switch_anim_state),
          GEO_OPEN_NODE(),
             GEO_DISPLAY_LIST(LAYER_OPAQUE, boo_seg5_dl_0500C1B0),
             GEO_DISPLAY_LIST(LAYER_TRANSPARENT, boo_seg5_dl_0500C1B0),
          GEO_CLOSE_NODE(),
+#endif
       GEO_CLOSE_NODE(),
    GEO_CLOSE_NODE(),
    GEO_END(),
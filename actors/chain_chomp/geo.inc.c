@@ -1,5 +1,11 @@
 // 0x0D0005EC
 const GeoLayout chain_chomp_geo[] = {
+#ifdef CHAIN_CHOMP_RENDER_ONLY_CHAIN
+   // Large enough to keep the chain visible while the chain chomp itself is off screen.
+   GEO_CULLING_RADIUS(CHAIN_CHOMP_NUM_SEGMENTS * 200),
+   GEO_OPEN_NODE(),
+   GEO_ASM(0, geo_chain_chomp_draw_chain),
+#endif
    GEO_SHADOW(SHADOW_CIRCLE_4_VERTS, 0x96, 200),
    GEO_OPEN_NODE(),
       GEO_SCALE(0x00, 16384),
@@ -17,5 +23,8 @@ const GeoLayout chain_chomp_geo[] = {
          GEO_CLOSE_NODE(),
       GEO_CLOSE_NODE(),
    GEO_CLOSE_NODE(),
+#ifdef CHAIN_CHOMP_RENDER_ONLY_CHAIN
+   GEO_CLOSE_NODE(),
+#endif
    GEO_END(),
 };
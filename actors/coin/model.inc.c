@@ -128,6 +128,36 @@ const Gfx coin_seg3_dl_end[] = {
     gsSPEndDisplayList(),
 };
 
+#ifdef COIN_MANAGER
+// Used by the coin manager to draw many coins after the texture was loaded by the first one.
+const Gfx coin_seg3_dl_batch_begin[] = {
+    gsDPPipeSync(),
+    gsSPClearGeometryMode(G_LIGHTING),
+    gsDPSetCombineMode(G_CC_MODULATEIA, G_CC_MODULATEIA),
+    gsSPTexture(32767, 32767, 0, G_TX_RENDERTILE, G_ON),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_dl_yellow_batch[] = {
+    gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_dl_yellow_batch_r[] = {
+    gsSPVertex(coin_seg3_vertex_yellow_r, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_dl_batch_end[] = {
+    gsSPTexture(0x0001, 0x0001, 0, G_TX_RENDERTILE, G_OFF),
+    gsDPSetCombineMode(G_CC_SHADE, G_CC_SHADE),
+    gsSPSetGeometryMode(G_LIGHTING),
+    gsSPEndDisplayList(),
+};
+#endif
+
 // YELLOW
 const Gfx coin_seg3_dl_yellow_0[] = {
     gsDPPipeSync(),
@@ -508,6 +538,30 @@ const Gfx coin_seg3_sub_dl_end[] = {
     gsSPEndDisplayList(),
 };
 
+#ifdef COIN_MANAGER
+// Used by the coin manager to draw many coins after the texture was loaded by the first one.
+const Gfx coin_seg3_dl_batch_begin[] = {
+    gsDPPipeSync(),
+    gsSPClearGeometryMode(G_LIGHTING),
+    gsDPSetCombineMode(G_CC_MODULATEIA, G_CC_MODULATEIA),
+    gsSPTexture(0x8000, 0x8000, 0, G_TX_RENDERTILE, G_ON),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_dl_yellow_batch[] = {
+    gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_dl_batch_end[] = {
+    gsSPTexture(0x0001, 0x0001, 0, G_TX_RENDERTILE, G_OFF),
+    gsDPSetCombineMode(G_CC_SHADE, G_CC_SHADE),
+    gsSPSetGeometryMode(G_LIGHTING),
+    gsSPEndDisplayList(),
+};
+#endif
+
 // 0x03007800 - 0x03007828
 const Gfx coin_seg3_dl_yellow_front[] = {
     gsDPPipeSync(),
@@ -87,6 +87,14 @@ extern const Gfx coin_seg3_dl_red_tilt_right[];
 extern const Gfx coin_seg3_dl_red_side[];
 extern const Gfx coin_seg3_dl_red_tilt_left[];
 #endif
+#ifdef COIN_MANAGER
+extern const Gfx coin_seg3_dl_batch_begin[];
+extern const Gfx coin_seg3_dl_yellow_batch[];
+#ifdef IA8_30FPS_COINS
+extern const Gfx coin_seg3_dl_yellow_batch_r[];
+#endif
+extern const Gfx coin_seg3_dl_batch_end[];
+#endif
 
 // dirt
 extern const GeoLayout dirt_animation_geo[];
@@ -9,6 +9,14 @@ extern const Gfx boo_seg5_dl_0500BEE0[];
 extern const Gfx boo_seg5_dl_0500BF48[];
 extern const Gfx boo_seg5_dl_0500BFA0[];
 extern const Gfx boo_seg5_dl_0500C1B0[];
+#ifdef TRANSPARENT_OBJECT_BATCHING
+extern const Gfx boo_seg5_dl_batch_mouth_material[];
+extern const Gfx boo_seg5_dl_batch_mouth[];
+extern const Gfx boo_seg5_dl_batch_eyes_material[];
+extern const Gfx boo_seg5_dl_batch_eyes[];
+extern const Gfx boo_seg5_dl_batch_body_material[];
+extern const Gfx boo_seg5_dl_batch_end[];
+#endif
 
 // book
 extern const GeoLayout bookend_geo[];
@@ -3484,3 +3484,6 @@ const s16 seg2_painting_mesh_neighbor_tris[] = {
       3, 240, 242, 244,
       1, 243,
 };
+
+// Textures shared by several levels and actor groups, see tools/texture_dedup.py.
+#include "bin/shared_textures.inc.c"
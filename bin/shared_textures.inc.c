@@ -0,0 +1,3 @@
+// Generated by tools/texture_dedup.py, do not edit.
+// Textures used by more than one level or actor group, kept resident in segment 2.
+// Keeps 0 bytes of RAM in use for the whole game.
@@ -754,7 +754,7 @@ const BehaviorScript bhvRotatingPlatform[] = {
     SET_HOME(),
     BEGIN_LOOP(),
         CALL_NATIVE(bhv_rotating_platform_loop),
-        CALL_NATIVE(load_object_collision_model),
+        CALL_NATIVE(load_object_collision_model_rotating),
     END_LOOP(),
 };
 
@@ -834,7 +834,7 @@ const BehaviorScript bhvWfRotatingWoodenPlatform[] = {
     LOAD_COLLISION_DATA(wf_seg7_collision_clocklike_rotation),
     BEGIN_LOOP(),
         CALL_NATIVE(bhv_wf_rotating_wooden_platform_loop),
-        CALL_NATIVE(load_object_collision_model),
+        CALL_NATIVE(load_object_collision_model_rotating),
     END_LOOP(),
 };
 
@@ -993,6 +993,16 @@ const BehaviorScript bhvYellowCoin[] = {
     END_LOOP(),
 };
 
+#ifdef COIN_MANAGER
+const BehaviorScript bhvCoinManager[] = {
+    BEGIN(OBJ_LIST_LEVEL),
+    OR_INT(oFlags, OBJ_FLAG_ACTIVE_FROM_AFAR),
+    BEGIN_LOOP(),
+        CALL_NATIVE(bhv_coin_manager_loop),
+    END_LOOP(),
+};
+#endif
+
 const BehaviorScript bhvTemporaryYellowCoin[] = {
     BEGIN(OBJ_LIST_LEVEL),
     BILLBOARD(),
@@ -2054,7 +2064,7 @@ const BehaviorScript bhvTiltingBowserLavaPlatform[] = {
     SET_HOME(),
     BEGIN_LOOP(),
         CALL_NATIVE(cur_obj_rotate_face_angle_using_vel),
-        CALL_NATIVE(load_object_collision_model),
+        CALL_NATIVE(load_object_collision_model_cached),
     END_LOOP(),
 };
 
@@ -2066,7 +2076,7 @@ const BehaviorScript bhvFallingBowserPlatform[] = {
     SET_HOME(),
     BEGIN_LOOP(),
         CALL_NATIVE(bhv_falling_bowser_platform_loop),
-        CALL_NATIVE(load_object_collision_model),
+        CALL_NATIVE(load_object_collision_model_cached),
     END_LOOP(),
 };
 
@@ -2389,7 +2399,7 @@ const BehaviorScript bhvLllRotatingHexagonalRing[] = {
     LOAD_COLLISION_DATA(lll_seg7_collision_rotating_platform),
     BEGIN_LOOP(),
         CALL_NATIVE(bhv_lll_rotating_hexagonal_ring_loop),
-        CALL_NATIVE(load_object_collision_model),
+        CALL_NATIVE(load_object_collision_model_rotating),
     END_LOOP(),
 };
 
@@ -5427,7 +5437,7 @@ const BehaviorScript bhvTTCRotatingSolid[] = {
     SET_INT(oTTCRotatingSolidNumTurns, 1),
     BEGIN_LOOP(),
         CALL_NATIVE(bhv_ttc_rotating_solid_update),
-        CALL_NATIVE(load_object_collision_model),
+        CALL_NATIVE(load_object_collision_model_rotating),
     END_LOOP(),
 };
 
@@ -5440,7 +5450,7 @@ const BehaviorScript bhvTTCPendulum[] = {
     SET_FLOAT(oTTCPendulumAccelDir, 1),
     BEGIN_LOOP(),
         CALL_NATIVE(bhv_ttc_pendulum_update),
-        CALL_NATIVE(load_object_collision_model),
+        CALL_NATIVE(load_object_collision_model_rotating),
     END_LOOP(),
 };
 
@@ -5481,7 +5491,7 @@ const BehaviorScript bhvTTCCog[] = {
     CALL_NATIVE(bhv_ttc_cog_init),
     BEGIN_LOOP(),
         CALL_NATIVE(bhv_ttc_cog_update),
-        CALL_NATIVE(load_object_collision_model),
+        CALL_NATIVE(load_object_collision_model_rotating),
     END_LOOP(),
 };
 
@@ -5529,7 +5539,7 @@ const BehaviorScript bhvTTCSpinner[] = {
     SET_FLOAT(oCollisionDistance, 450),
     BEGIN_LOOP(),
         CALL_NATIVE(bhv_ttc_spinner_update),
-        CALL_NATIVE(load_object_collision_model),
+        CALL_NATIVE(load_object_collision_model_rotating),
     END_LOOP(),
 };
 
@@ -5580,7 +5590,7 @@ const BehaviorScript bhvOctagonalPlatformRotating[] = {
     CALL_NATIVE(bhv_rotating_octagonal_plat_init),
     BEGIN_LOOP(),
         CALL_NATIVE(bhv_rotating_octagonal_plat_loop),
-        CALL_NATIVE(load_object_collision_model),
+        CALL_NATIVE(load_object_collision_model_rotating),
     END_LOOP(),
 };
 
@@ -58,6 +58,9 @@ extern const BehaviorScript bhvCoinFormationSpawnedCoin[];
 extern const BehaviorScript bhvCoinFormation[];
 extern const BehaviorScript bhvOneCoin[];
 extern const BehaviorScript bhvYellowCoin[];
+#ifdef COIN_MANAGER
+extern const BehaviorScript bhvCoinManager[];
+#endif
 extern const BehaviorScript bhvTemporaryYellowCoin[];
 extern const BehaviorScript bhvThreeCoinsSpawn[];
 extern const BehaviorScript bhvTenCoinsSpawn[];
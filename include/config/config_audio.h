@@ -13,3 +13,23 @@
 // Use a much better implementation of reverb over vanilla's fake echo reverb. Great for caves or eerie levels, as well as just a better audio experience in general.
 // Reverb parameters can be configured in audio/synthesis.c to meet desired aesthetic/performance needs. Currently US/JP only. Hurts emulator and console performance.
 //#define BETTER_REVERB
+
+// Notes are synthesized with less work the quieter they are. Quiet notes skip headset pan effects, and notes too quiet to hear
+// aren't synthesized at all while their playback position keeps moving.
+// Saves RSP time and audio command list space in busy scenes with many sound effects. Currently US/JP only.
+// #define AUDIO_VOICE_LOD
+
+// Notes at zero volume aren't synthesized while their playback position keeps moving. When they get louder again, decoding
+// restarts from the nearest ADPCM frame, so the first few samples after that can differ slightly from a full synthesis.
+// Envelope command templates aren't shared between notes, only the synthesis of silent notes is skipped.
+// Saves RSP time in scenes with many faded out notes. Currently US/JP only.
+// #define AUDIO_NOTE_ELISION
+
+// Vibrato and portamento are only evaluated every few audio updates, set by this define, and the pitch is linearly interpolated
+// in between. Vibrato timing is unchanged since its phase still advances every update. Saves audio thread time with many notes.
+// Set to 1 or comment out to evaluate them every update. Currently US/JP only.
+// #define AUDIO_CONTROL_RATE 2
+
+// Requests for continuous sounds that would be played at no volume at all are dropped as soon as they are made, so they don't
+// take up a channel. Only JP fades sounds out completely, past the level's acoustic reach, so this does nothing on other versions.
+// #define AUDIO_AUDIBILITY_CULLING
@@ -33,6 +33,10 @@
 // Enables Puppy Camera 2, a rewritten camera that can be freely configured and modified.
 // #define PUPPYCAM
 
+// PuppyCam reuses the last frame's collision rays while the target and camera direction haven't changed and no object collision
+// is near them, instead of casting both rays through the level again. The result is the same as casting them.
+// #define PUPPYCAM_COHERENT_COLLISION
+
 // Note: Reonucam is available, but because we had no time to test it properly, it's included as a patch rather than being in the code by default.
 // Run this command to apply the patch if you want to use it: 
 // tools/apply_patch.sh enhancements/reonucam.patch
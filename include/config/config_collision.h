@@ -14,6 +14,35 @@
 // Allow all surfaces types to have force, (doesn't require setting force, just allows it to be optional).
 #define ALL_SURFACES_HAVE_FORCE
 
+// Object collision detection copies the hitboxes of tangible objects into a compact array once per frame and tests pairs
+// against that, instead of walking the object lists and reading every field from each object. Reduces data cache misses
+// in object heavy scenes.
+#define COMPACT_OBJECT_COLLISION
+
+// Objects that load their collision with load_object_collision_model_cached, such as the tilting platform in the BitFS
+// Bowser fight and the BitS arena pieces, keep a copy of their transformed surfaces. While they don't move, the copy is added
+// back each frame instead of transforming the vertices and recomputing the normals again. Bowser's flames also stop probing
+// for floors and walls once they have landed on static ground. Uses about 12KB of RAM.
+// #define OBJECT_COLLISION_CACHE
+
+// Objects that keep rotating and load their collision with load_object_collision_model_rotating, such as the TTC cogs, hands
+// and spinners and the WF rotating platforms, rotate normals that are computed once per collision model instead of computing
+// them again from the transformed vertices, which skips the cross product and normalization for every surface each frame.
+// Floors can differ from vanilla by a fraction of a unit on sloped surfaces. Uses about 6KB of RAM.
+// Only the normals are saved: the vertices are still transformed and the surfaces rebuilt every frame, so these objects
+// still fill the dynamic surface pool as much as before.
+// #define LOCAL_COLLISION_NORMALS
+
+// Objects remember how far they were from the closest level wall at their last wall check, and skip checking the level's walls
+// again until they move further than that or into another cell. Walls belonging to objects are still checked every time.
+#define WALL_CLEARANCE_CACHE
+
+// Once an area's collision is loaded, the floors of each cell are also copied into a contiguous array of 16 byte records that
+// only hold what find_floor needs to reject a floor. The full surface is only read for floors that Mario is above, so walking
+// a cell reads far fewer data cache lines. Results are identical to walking the surface lists. The records are kept at the end
+// of the surface node pool, two nodes each, so SURFACE_NODE_POOL_SIZE may need raising in levels that use most of it.
+// #define COMPACT_STATIC_FLOORS
+
 // Number of walls that can push Mario at once. Vanilla is 4.
 #define MAX_REFERENCED_WALLS 4
 
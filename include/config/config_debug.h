@@ -28,6 +28,10 @@
 // Use cycles instead of microseconds in Puppyprint debug output.
 // #define PUPPYPRINT_DEBUG_CYCLES
 
+// Adds an "RDP Layers" page to the Puppyprint profiler, which splits the RDP's time between the render layers of the master list.
+// While the page is open a full sync is inserted after every layer, which costs some RDP time of its own.
+// #define PUPPYPRINT_RDP_MARKERS
+
 // A vanilla style debug mode. It doesn't rely on a text engine, but it's much less powerful that PUPPYPRINT_DEBUG. 
 // Press DPAD left to show the debug UI.
 // #define VANILLA_STYLE_CUSTOM_DEBUG
@@ -49,5 +53,9 @@
 // Include vanilla debug functionality.
 // #define VANILLA_DEBUG
 
+// Counts objects that were changed by another object that OBJECT_UPDATE_BATCHING reordered around them, in gNumObjectUpdateOrderWarnings.
+// Logs each one to the puppyprint console if PUPPYPRINT_DEBUG is enabled. Reading another object isn't detected.
+// #define OBJECT_UPDATE_BATCHING_DEBUG
+
 // Forces a crash when the game starts. Useful for debugging the crash screen.
 // #define DEBUG_FORCE_CRASH_ON_BOOT
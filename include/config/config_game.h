@@ -52,6 +52,11 @@
 // Number of possible unique model ID's (keep it higher than 256)
 #define MODEL_ID_COUNT 256
 
+// Models loaded with LOAD_MODEL_FROM_GEO only have their graph built the first time an object uses them,
+// instead of when the level is loaded. Models that are never used in a level don't take up any RAM,
+// and model IDs that share a geo layout share one graph, so obj_has_model can't tell those apart.
+// #define LAZY_MODEL_LOADING
+
 // Number of supported areas per level.
 #define AREA_COUNT 8
 
@@ -80,3 +85,14 @@
 
 // The level that the game starts in after file select. The levelscript needs to have a MARIO_POS command for this to work.
 #define START_LEVEL LEVEL_CASTLE_GROUNDS
+
+// Objects in each object list are updated in groups that share a behavior instead of in list order, so the same behavior
+// code stays in the instruction cache for a whole group. Children are still updated after their parents, and the object lists
+// are still updated in the usual order. Behaviors that read or change other objects in the same list may see them one frame
+// earlier or later than usual, see OBJECT_UPDATE_BATCHING_DEBUG to detect this.
+// #define OBJECT_UPDATE_BATCHING
+
+// Level scripts load runs of LOAD_YAY0, LOAD_YAY0_TEXTURE and LOAD_RAW commands together, reading each segment from ROM
+// while the one before it is being decompressed. Uses more of the main pool while loading, and falls back to loading
+// one segment at a time when there isn't enough room. Only works with YAY0, MIO0 and RNC compression.
+// #define LEVEL_LOAD_PLANS
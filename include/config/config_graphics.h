@@ -70,6 +70,30 @@
 // NOTE: Stil breaks occasionally, and PUPPYLIGHT_NODE doesn't work in areas that aren't area 1.
 // #define PUPPYLIGHTS
 
+// Short lived effects (coin sparkles and the dust spawned by cur_obj_spawn_particles) are stored in a small fixed pool
+// instead of being objects, and drawn as billboards in one display list per layer. Frees up object slots during particle bursts.
+// #define EFFECT_POOL
+
+// While the pause menu is open, the scene is drawn once and copied into the z buffer, which is then drawn back as a single image
+// behind the menu instead of processing and rendering the whole level again each frame. Effects that animate while paused,
+// such as snow, stop moving. Emulators need framebuffer emulation enabled, or the scene behind the menu will be garbage.
+// Only the pause menu is covered: dialogs and the course complete screen still draw the scene every frame,
+// since Mario, the camera and talking objects keep animating behind them.
+// #define FROZEN_PAUSE_FRAME
+
+// The power meter, camera status, keys and the lives, coins and star counters keep their display lists between frames, and only rebuild
+// them when the value they show or their position changes, instead of building them again every frame. Uses about 9KB of RAM.
+// #define RETAINED_HUD
+
+// Generated display list functions that opt in with geo_memo_begin reuse the list they built for the same node and inputs
+// on earlier frames, instead of building it again every frame. Water boxes only rewrite the vertices of their quads, and idle
+// paintings keep their matrices. Cache hits compare everything the list was built from. Uses about 37KB of RAM.
+// #define GEO_MEMOIZATION
+
+// Boos are drawn together at the end of their layer, setting up each of their materials once per frame instead of once per boo,
+// with only the matrix and opacity changing between them. Saves texture loads in rooms full of boos.
+// #define TRANSPARENT_OBJECT_BATCHING
+
 // Uses the correct "up" vector for the guLookAtReflect call in geo_process_master_list_sub.
 // It is sideways in vanilla, and since vanilla's environment map textures are sideways too, they will appear as sideways in-game if this is enabled.
 // Make sure your custom environment map textures are the correct orientation.
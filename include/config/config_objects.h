@@ -17,6 +17,12 @@
 // Allow for retries on collecting the remaining blue coins from a blue coin switch.
 //#define BLUE_COIN_SWITCH_RETRY
 
+// Static yellow coins and coins in coin formations are stored in a compact array instead of being objects,
+// with their pickups checked in a single pass and all of them drawn in one batched display list.
+// This frees up a lot of object slots in coin heavy levels. Managed coins are drawn without shadows.
+// Coins that can move, such as coins dropped by enemies, are still objects.
+// #define COIN_MANAGER
+
 // -- GOOMBA --
 
 // Tiny Goombas (from THI) always drop their coin.
@@ -59,11 +65,20 @@
 // The speed of a platform on a track can be controlled by standing near the front or back of it
 //#define CONTROLLABLE_PLATFORM_SPEED
 
+// Platforms on tracks keep track of how far along their path they are, and look up their position and heading from the
+// cumulative length and direction of each segment of the path, which are computed once per level.
+// This avoids measuring the current segment again every frame, and spawns track balls without walking the path.
+#define PATH_CACHE
+
 // -- CHAIN CHOMP --
 
 // The number of chain balls the Chain Chomp has.  Vanilla is 5.
 #define CHAIN_CHOMP_NUM_SEGMENTS 5
 
+// The Chain Chomp draws its chain itself instead of spawning an object for each chain ball,
+// which makes raising CHAIN_CHOMP_NUM_SEGMENTS much cheaper. The chain balls are drawn without shadows.
+// #define CHAIN_CHOMP_RENDER_ONLY_CHAIN
+
 // -- POKEY --
 
 // The number of parts Pokey has, including the head. Vanilla is 5, max is 30.
@@ -73,3 +88,8 @@
 
 // The number of segments Wiggler has, not including the head. Vanilla is 4.
 #define WIGGLER_NUM_SEGMENTS     4
+
+// -- BOWSER --
+
+// Bowser's flames stop checking for floors and walls once they land on static ground, since they don't move after that.
+// #define BOWSER_FLAME_SKIP_LANDED_COLLISION
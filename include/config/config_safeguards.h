@@ -75,12 +75,22 @@
     #undef VANILLA_STYLE_CUSTOM_DEBUG
     #undef PUPPYPRINT_DEBUG
     #undef PUPPYPRINT_DEBUG_CYCLES
+    #undef PUPPYPRINT_RDP_MARKERS
     #undef VISUAL_DEBUG
     #undef UNLOCK_ALL
     #undef COMPLETE_SAVE_FILE
     #undef DEBUG_FORCE_CRASH_ON_BOOT
+    #undef OBJECT_UPDATE_BATCHING_DEBUG
 #endif // DISABLE_ALL
 
+#ifndef OBJECT_UPDATE_BATCHING
+    #undef OBJECT_UPDATE_BATCHING_DEBUG // There is nothing to check without batching.
+#endif // !OBJECT_UPDATE_BATCHING
+
+#if !PUPPYPRINT_DEBUG
+    #undef PUPPYPRINT_RDP_MARKERS // Only the profiler reads the markers.
+#endif // !PUPPYPRINT_DEBUG
+
 
 /*****************
  * config_camera
@@ -116,6 +126,10 @@
     #define START_LEVEL LEVEL_CASTLE_GROUNDS
 #endif
 
+#if defined(GZIP) || defined(UNCOMPRESSED) || defined(NO_SEGMENTED_MEMORY)
+    #undef LEVEL_LOAD_PLANS // Load plans only overlap reads with YAY0, MIO0 and RNC decompression.
+#endif
+
 
 /*****************
  * config_goddard
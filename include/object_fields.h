@@ -862,8 +862,14 @@
 #define /*0x0FC*/ oPlatformOnTrackStartWaypoint          OBJECT_FIELD_WAYPOINT(0x1D)
 #define /*0x100*/ oPlatformOnTrackPrevWaypoint           OBJECT_FIELD_WAYPOINT(0x1E)
 #define /*0x104*/ oPlatformOnTrackPrevWaypointFlags      OBJECT_FIELD_S32(0x1F)
+#ifdef PATH_CACHE
+#define /*0x108*/ oPlatformOnTrackPitch                  OBJECT_FIELD_S16(0x20, 0)
+#define /*0x10A*/ oPlatformOnTrackYaw                    OBJECT_FIELD_S16(0x20, 1)
+#define /*0x10C*/ oPlatformOnTrackDistAlongPath          OBJECT_FIELD_F32(0x21)
+#else
 #define /*0x108*/ oPlatformOnTrackPitch                  OBJECT_FIELD_S32(0x20)
 #define /*0x10C*/ oPlatformOnTrackYaw                    OBJECT_FIELD_S32(0x21)
+#endif
 #define /*0x110*/ oPlatformOnTrackOffsetY                OBJECT_FIELD_F32(0x22)
 #define /*0x1AC*/ oPlatformOnTrackIsNotSkiLift           OBJECT_FIELD_S16(0x49, 0)
 #define /*0x1AE*/ oPlatformOnTrackIsNotHMC               OBJECT_FIELD_S16(0x49, 1)
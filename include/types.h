@@ -282,6 +282,15 @@ struct PuppyLight {
 };
 #endif
 
+#ifdef WALL_CLEARANCE_CACHE
+struct WallClearance {
+    Vec3f pos;      // Where the clearance was measured, including the wall check's vertical offset.
+    f32 dist;       // No static wall in the cell was closer than this. 0 if it has to be measured again.
+    s16 cellX;      // The cell the clearance was measured in, since only that cell's walls were checked.
+    s16 cellZ;
+};
+#endif
+
 // NOTE: Since ObjectNode is the first member of Object, it is difficult to determine
 // whether some of these pointers point to ObjectNode or Object.
 
@@ -351,6 +360,9 @@ struct Object {
 #ifdef PUPPYLIGHTS
     struct PuppyLight puppylight;
 #endif
+#ifdef WALL_CLEARANCE_CACHE
+    struct WallClearance wallClearance;
+#endif
 };
 
 struct ObjectHitbox {
@@ -188,12 +188,7 @@ s32 get_vibrato_pitch_change(struct VibratoState *vib) {
 }
 #endif
 
-f32 get_vibrato_freq_scale(struct VibratoState *vib) {
-    if (vib->delay != 0) {
-        vib->delay--;
-        return 1;
-    }
-
+static void vibrato_update_extent_and_rate(struct VibratoState *vib) {
     if (vib->extentChangeTimer) {
         if (vib->extentChangeTimer == 1) {
             vib->extent = (s32) vib->seqChannel->vibratoExtentTarget;
@@ -222,6 +217,15 @@ f32 get_vibrato_freq_scale(struct VibratoState *vib) {
             vib->rate = (s32) vib->seqChannel->vibratoRateTarget;
         }
     }
+}
+
+f32 get_vibrato_freq_scale(struct VibratoState *vib) {
+    if (vib->delay != 0) {
+        vib->delay--;
+        return 1;
+    }
+
+    vibrato_update_extent_and_rate(vib);
 
     if (vib->extent == 0) {
         return 1.0f;
@@ -237,6 +241,79 @@ f32 get_vibrato_freq_scale(struct VibratoState *vib) {
 #endif
 }
 
+#if defined(AUDIO_CONTROL_RATE) && (defined(VERSION_US) || defined(VERSION_JP))
+/**
+ * Step the vibrato forward by the given number of updates and return the frequency scale
+ * after the last one. The integer phase, delay and extent and rate ramps are stepped for
+ * every update, but the curve and pitch bend table are only read once.
+ */
+static f32 get_vibrato_freq_scale_ahead(struct VibratoState *vib, s32 numUpdates) {
+    s32 i;
+
+    for (i = 0; i < numUpdates - 1; i++) {
+        if (vib->delay != 0) {
+            vib->delay--;
+            continue;
+        }
+
+        vibrato_update_extent_and_rate(vib);
+
+        if (vib->extent != 0) {
+            vib->time += vib->rate;
+        }
+    }
+
+    return get_vibrato_freq_scale(vib);
+}
+
+/**
+ * Step the portamento forward by the given number of updates and return the frequency scale
+ * after the last one.
+ */
+static f32 get_portamento_freq_scale_ahead(struct Portamento *p, s32 numUpdates) {
+    if (p->mode != 0) {
+        p->cur += p->speed * (numUpdates - 1);
+    }
+
+    return get_portamento_freq_scale(p);
+}
+
+/**
+ * Vibrato and portamento are evaluated once every AUDIO_CONTROL_RATE updates, looking that
+ * many updates ahead, and the frequency scales are linearly interpolated in between.
+ * The first update of a note is evaluated exactly so portamento starts on the right pitch.
+ */
+static void note_control_rate_update(struct Note *note) {
+    s32 numUpdates = AUDIO_CONTROL_RATE;
+    f32 scale;
+
+    if (note->controlRateTimer != 0 && note->controlRateTimer != CONTROL_RATE_TIMER_NEEDS_INIT) {
+        note->controlRateTimer--;
+        note->portamentoFreqScale += note->portamentoFreqStep;
+        note->vibratoFreqScale += note->vibratoFreqStep;
+        return;
+    }
+
+    if (note->controlRateTimer == CONTROL_RATE_TIMER_NEEDS_INIT) {
+        numUpdates = 1;
+    }
+
+    scale = get_portamento_freq_scale_ahead(&note->portamento, numUpdates);
+    note->portamentoFreqStep = (scale - note->portamentoFreqScale) / numUpdates;
+    note->portamentoFreqScale += note->portamentoFreqStep;
+
+    if (note->parentLayer != NO_LAYER) {
+        scale = get_vibrato_freq_scale_ahead(&note->vibratoState, numUpdates);
+        note->vibratoFreqStep = (scale - note->vibratoFreqScale) / numUpdates;
+        note->vibratoFreqScale += note->vibratoFreqStep;
+    } else {
+        note->vibratoFreqStep = 0.0f;
+    }
+
+    note->controlRateTimer = (numUpdates - 1);
+}
+#endif
+
 void note_vibrato_update(struct Note *note) {
 #if defined(VERSION_EU) || defined(VERSION_SH)
     if (note->portamento.mode != 0) {
@@ -245,6 +322,10 @@ void note_vibrato_update(struct Note *note) {
     if (note->vibratoState.active && note->parentLayer != NO_LAYER) {
         note->vibratoFreqScale = get_vibrato_freq_scale(&note->vibratoState);
     }
+#elif defined(AUDIO_CONTROL_RATE)
+    if (note->vibratoState.active) {
+        note_control_rate_update(note);
+    }
 #else
     if (note->vibratoState.active) {
         note->portamentoFreqScale = get_portamento_freq_scale(&note->portamento);
@@ -262,6 +343,9 @@ void note_vibrato_init(struct Note *note) {
 
     note->vibratoFreqScale = 1.0f;
     note->portamentoFreqScale = 1.0f;
+#if defined(AUDIO_CONTROL_RATE) && (defined(VERSION_US) || defined(VERSION_JP))
+    note->controlRateTimer = CONTROL_RATE_TIMER_NEEDS_INIT;
+#endif
 
     struct VibratoState *vib = &note->vibratoState;
 
@@ -39,6 +39,11 @@ enum ADSRDelays {
 #define BSWAP16(x) (((x) & 0xff) << 8 | (((x) >> 8) & 0xff))
 #endif
 
+#ifdef AUDIO_CONTROL_RATE
+// Set by note_vibrato_init so the first update of a note is evaluated exactly.
+#define CONTROL_RATE_TIMER_NEEDS_INIT 0xFF
+#endif
+
 void sequence_player_process_sound(struct SequencePlayer *seqPlayer);
 void note_vibrato_update(struct Note *note);
 void note_vibrato_init(struct Note *note);
@@ -352,6 +352,7 @@ u8 sCurrentSound[SOUND_BANK_COUNT][MAX_CHANNELS_PER_SOUND_BANK]; // index into s
 struct SoundCharacteristics sSoundBanks[SOUND_BANK_COUNT][40];
 
 u8 sSoundMovingSpeed[SOUND_BANK_COUNT];
+
 u8 sBackgroundMusicTargetVolume;
 static u8 sLowerBackgroundMusicVolume;
 struct SequenceQueueItem sBackgroundMusicQueue[MAX_BACKGROUND_MUSIC_QUEUE_SIZE];
@@ -683,10 +684,64 @@ struct SPTask *create_next_audio_frame_task(void) {
 }
 #endif
 
+#ifdef AUDIO_AUDIBILITY_CULLING
+/**
+ * The volume range update_game_sound passes to get_sound_volume for a bank, or 0 if it plays at full volume.
+ */
+static f32 get_sound_bank_volume_range(s32 bank) {
+    switch (bank) {
+        case SOUND_BANK_ACTION:
+        case SOUND_BANK_VOICE:
+        case SOUND_BANK_MOVING:
+            return VOLUME_RANGE_UNK1;
+        case SOUND_BANK_MENU:
+            return 0.0f;
+        default:
+            return VOLUME_RANGE_UNK2;
+    }
+}
+
+/**
+ * Whether a sound requested at the given camera space position would be played at any volume.
+ * get_sound_volume only gives 0 to banks with a volume range of 1, past the distance where their
+ * falloff ends. That only happens on JP, so other versions don't drop anything.
+ * Discrete sounds are always kept, since their source may come closer while they play,
+ * and so are sounds that lower the background music even when they can't be heard.
+ */
+static s32 is_sound_request_audible(u32 bits, f32 *pos) {
+    s32 bank = (bits & SOUNDARGS_MASK_BANK) >> SOUNDARGS_SHIFT_BANK;
+    f32 silentDistance;
+
+    if ((bits & (SOUND_DISCRETE | SOUND_NO_VOLUME_LOSS | SOUND_LOWER_BACKGROUND_MUSIC))
+        || get_sound_bank_volume_range(bank) < 1.0f) {
+        return TRUE;
+    }
+
+#ifdef VERSION_JP
+    silentDistance = sLevelAcousticReaches[gCurrLevelNum];
+#else
+    silentDistance = AUDIO_MAX_DISTANCE;
+#endif
+
+    // Most far away sources are past it on a single axis, which skips the square root.
+    if (absf(pos[0]) > silentDistance || absf(pos[1]) > silentDistance || absf(pos[2]) > silentDistance) {
+        return FALSE;
+    }
+
+    // Same distance and comparison as process_sound_request and get_sound_volume.
+    return !(silentDistance < sqrtf(sqr(pos[0]) + sqr(pos[1]) + sqr(pos[2])));
+}
+#endif
+
 /**
  * Called from threads: thread5_game_loop
  */
 void play_sound(s32 soundBits, f32 *pos) {
+#ifdef AUDIO_AUDIBILITY_CULLING
+    if (!is_sound_request_audible(soundBits, pos)) {
+        return;
+    }
+#endif
     sSoundRequests[sSoundRequestCount].soundBits = soundBits;
     sSoundRequests[sSoundRequestCount].position = pos;
     sSoundRequestCount++;
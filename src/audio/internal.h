@@ -664,14 +664,15 @@ struct Note {
     /*0x00*/ u8 stereoStrongLeft     : 1;
     /*0x00*/ u8 stereoHeadsetEffects : 1;
     /*0x01*/ u8 usesHeadsetPanEffects;
-    /*0x02*/ u8 unk2;
+    /*0x02*/ u8 voiceLodTier; // Only used with AUDIO_VOICE_LOD or AUDIO_NOTE_ELISION, see enum VoiceLodTiers
     /*0x03*/ u8 sampleDmaIndex;
     /*0x04, 0x30*/ u8 priority;
     /*0x05*/ u8 sampleCount; // 0, 8, 16, 32 or 64
     /*0x06*/ u8 instOrWave;
     /*0x07*/ u8 bankId; // in NoteSubEu on EU
     /*0x08*/ s16 adsrVolScale;
-    /*    */ u8 pad1[2];
+    /*0x0A*/ u8 controlRateTimer; // Only used with AUDIO_CONTROL_RATE, updates left until the next control tick
+    /*    */ u8 pad1[1];
     /*0x0C, 0xB3*/ u16 headsetPanRight;
     /*0x0E, 0xB4*/ u16 headsetPanLeft;
     /*0x10*/ u16 prevHeadsetPanRight;
@@ -699,7 +700,9 @@ struct Note {
     /*0xA0*/ s16 reverbVolShifted; // Q1.15
     /*0xA2*/ s16 unused2; // never read, set to 0
     /*0xA4, 0x00*/ struct AudioListItem listItem;
-    /*          */ u8 pad2[0xc];
+    /*0xB4*/ f32 portamentoFreqStep; // Only used with AUDIO_CONTROL_RATE
+    /*0xB8*/ f32 vibratoFreqStep; // Only used with AUDIO_CONTROL_RATE
+    /*    */ u8 pad2[0x4];
 }; // size = 0xC0
 #endif
 
@@ -39,6 +39,28 @@
 
 #define AUDIO_ALIGN(val, amnt) (((val) + (1 << amnt) - 1) & ~((1 << amnt) - 1))
 
+#if (defined(AUDIO_VOICE_LOD) || defined(AUDIO_NOTE_ELISION)) && !defined(VERSION_EU)
+#define SKIP_SILENT_NOTES
+
+#ifdef AUDIO_VOICE_LOD
+// Notes quieter than this skip headset pan effects.
+#define VOICE_LOD_QUIET_VOLUME 0x800
+// Notes quieter than this aren't synthesized at all, only their playback position moves on.
+// note_set_vel_pan_reverb gives out volumes in steps of 0x100, so this skips the first step above silence too.
+#define VOICE_LOD_SILENT_VOLUME 0x200
+#else
+// Without voice LOD, only notes below the first volume step of note_set_vel_pan_reverb are skipped.
+#define VOICE_LOD_QUIET_VOLUME 0
+#define VOICE_LOD_SILENT_VOLUME 0x100
+#endif
+
+enum VoiceLodTiers {
+    VOICE_LOD_FULL,
+    VOICE_LOD_QUIET,
+    VOICE_LOD_SILENT,
+};
+#endif
+
 #if defined(BETTER_REVERB) && (defined(VERSION_US) || defined(VERSION_JP))
 /* ----------------------------------------------------------------------BEGIN REVERB PARAMETERS---------------------------------------------------------------------- */
 
@@ -822,6 +844,101 @@ u64 *synthesis_do_one_audio_update(s16 *aiBuf, s32 bufLen, u64 *cmd, s32 updateI
 }
 #endif
 
+#ifdef SKIP_SILENT_NOTES
+/**
+ * Choose how much work to spend on a note based on how loud it is now or is ramping to.
+ * Notes that are being released are treated as half as loud, since they are on their way out.
+ */
+static s32 note_get_voice_lod_tier(struct Note *note) {
+    s32 volume = MAX(MAX(note->curVolLeft, note->curVolRight), MAX(note->targetVolLeft, note->targetVolRight));
+
+    if (note->needsInit) {
+        return VOICE_LOD_FULL;
+    }
+
+    if (note->priority == NOTE_PRIORITY_STOPPING) {
+        volume >>= 1;
+    }
+
+    if (volume < VOICE_LOD_SILENT_VOLUME) {
+        return VOICE_LOD_SILENT;
+    } else if (volume < VOICE_LOD_QUIET_VOLUME) {
+        return VOICE_LOD_QUIET;
+    }
+
+    return VOICE_LOD_FULL;
+}
+
+/**
+ * Move a note's playback position along as if it had been synthesized for bufLen samples,
+ * following the same loop and end handling as synthesis_process_notes.
+ * The ADPCM decoder state isn't kept up to date, see note_resume_samples.
+ */
+static void note_skip_samples(struct Note *note, s32 bufLen) {
+    struct AdpcmLoop *loopInfo;
+    f32 resamplingRate;
+    s32 nParts;
+
+    if (note->frequency < 2.0f) {
+        nParts = 1;
+        resamplingRate = MIN(note->frequency, 1.99996f);
+    } else {
+        nParts = 2;
+        resamplingRate = (MIN(note->frequency, 3.99993f) * 0.5f);
+    }
+
+    u32 samplesLenFixedPoint = note->samplePosFrac + (((u16)(s32)(resamplingRate * 32768.0f) * bufLen) * 2);
+    note->samplePosFrac = (samplesLenFixedPoint & 0xFFFF);
+
+    if (note->sound == NULL) {
+        // Wave synthesis notes wrap around on their own.
+        note->samplePosInt += (samplesLenFixedPoint >> 0x10);
+        return;
+    }
+
+    loopInfo = note->sound->sample->loop;
+    s32 nSamples = ((samplesLenFixedPoint >> 0x10) * nParts);
+    s32 samplePos = note->samplePosInt;
+    s32 samplesRemaining = (loopInfo->end - samplePos);
+
+    if (nSamples >= samplesRemaining) {
+        if (loopInfo->count == 0) {
+            note->samplePosInt = 0;
+            note->finished = TRUE;
+            ((struct vNote *)note)->enabled = FALSE;
+            return;
+        }
+
+        nSamples -= samplesRemaining;
+        if (loopInfo->end > loopInfo->start) {
+            nSamples %= (loopInfo->end - loopInfo->start);
+        }
+        samplePos = loopInfo->start;
+    }
+
+    // The loop's decoder state is only valid at the start of the loop.
+    note->restart = (samplePos == loopInfo->start && nSamples == 0);
+    note->samplePosInt = (samplePos + nSamples);
+}
+
+/**
+ * Get a note ready to be synthesized again after note_skip_samples, returning the ADPCM flags for its first decode.
+ * The decoder state left over from before the skip belongs to a different position, so decoding starts afresh
+ * from the start of the current ADPCM frame, the same way a new note starts from sample 0.
+ */
+static s32 note_resume_samples(struct Note *note) {
+    // The envelope mixer's state is out of date after skipping.
+    note->envMixerNeedsInit = TRUE;
+
+    if (note->sound == NULL || note->restart) {
+        return 0;
+    }
+
+    note->samplePosInt &= ~0xF;
+    return A_INIT;
+}
+#endif
+
 #ifdef VERSION_EU
 // Processes just one note, not all
 u64 *synthesis_process_note(struct Note *note, struct NoteSubEu *noteSubEu, struct NoteSynthesisState *synthesisState, UNUSED s16 *aiBuf, s32 bufLen, u64 *cmd) {
@@ -914,8 +1031,25 @@ u64 *synthesis_process_notes(s16 *aiBuf, s32 bufLen, u64 *cmd) {
         if (note->noteSubEu.enabled == FALSE) {
             return cmd;
         } else {
+#endif
+#ifdef SKIP_SILENT_NOTES
+            s32 prevLodTier = note->voiceLodTier;
+            note->voiceLodTier = note_get_voice_lod_tier(note);
+
+            if (note->voiceLodTier == VOICE_LOD_SILENT) {
+                note_skip_samples(note, bufLen);
+                note->curVolLeft = note->targetVolLeft;
+                note->curVolRight = note->targetVolRight;
+                continue;
+            }
+
 #endif
             flags = 0;
+#ifdef SKIP_SILENT_NOTES
+            if (prevLodTier == VOICE_LOD_SILENT) {
+                flags = note_resume_samples(note);
+            }
+#endif
 #ifdef VERSION_EU
             tempBufLen = bufLen;
 #endif
@@ -1266,6 +1400,12 @@ u64 *synthesis_process_notes(s16 *aiBuf, s32 bufLen, u64 *cmd) {
                 flags = A_INIT;
                 note->needsInit = FALSE;
             }
+#ifdef SKIP_SILENT_NOTES
+            else if (prevLodTier == VOICE_LOD_SILENT) {
+                // The resampler's history is out of date after skipping.
+                flags = A_INIT;
+            }
+#endif
 
             cmd = final_resample(cmd, note, bufLen * 2, resamplingRateFixedPoint,
                                  noteSamplesDmemAddrBeforeResampling, flags);
@@ -1277,6 +1417,21 @@ u64 *synthesis_process_notes(s16 *aiBuf, s32 bufLen, u64 *cmd) {
             } else if (noteSubEu->headsetPanLeft != 0 || synthesisState->prevHeadsetPanLeft != 0) {
                 leftRight = 2;
 #else
+#ifdef SKIP_SILENT_NOTES
+            // Quiet notes are mixed without headset pan effects, which are restarted once they get louder.
+            u8 usesHeadsetPanEffects = note->usesHeadsetPanEffects;
+            if (note->voiceLodTier != VOICE_LOD_FULL) {
+                note->usesHeadsetPanEffects = FALSE;
+                note->prevHeadsetPanRight = 0;
+                note->prevHeadsetPanLeft = 0;
+            } else if (prevLodTier != VOICE_LOD_FULL) {
+                flags = A_INIT;
+            }
+
+            if (!note->usesHeadsetPanEffects) {
+                leftRight = 0;
+            } else
+#endif
             if (note->headsetPanRight != 0 || note->prevHeadsetPanRight != 0) {
                 leftRight = 1;
             } else if (note->headsetPanLeft != 0 || note->prevHeadsetPanLeft != 0) {
@@ -1300,6 +1455,9 @@ u64 *synthesis_process_notes(s16 *aiBuf, s32 bufLen, u64 *cmd) {
             if (note->usesHeadsetPanEffects) {
                 cmd = note_apply_headset_pan_effects(cmd, note, bufLen * 2, flags, leftRight);
             }
+#ifdef SKIP_SILENT_NOTES
+            note->usesHeadsetPanEffects = usesHeadsetPanEffects;
+#endif
 #endif
         }
 #ifndef VERSION_EU
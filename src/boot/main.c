@@ -169,6 +169,11 @@ void start_sptask(s32 taskType) {
         gActiveSPTask = sCurrentDisplaySPTask;
     }
 
+#ifdef PUPPYPRINT_RDP_MARKERS
+    if (taskType == M_GFXTASK && gActiveSPTask->state == SPTASK_STATE_NOT_STARTED) {
+        puppyprint_rdp_markers_task_started(gActiveSPTask);
+    }
+#endif
     osSpTaskLoad(&gActiveSPTask->task);
     osSpTaskStartGo(&gActiveSPTask->task);
     gActiveSPTask->state = SPTASK_STATE_RUNNING;
@@ -241,6 +246,28 @@ void handle_vblank(void) {
     if (gVblankHandler3 != NULL) osSendMesg(gVblankHandler3->queue, gVblankHandler3->msg, OS_MESG_NOBLOCK);
 }
 
+#ifdef PUPPYPRINT_RDP_MARKERS
+void handle_dp_complete(void);
+
+/**
+ * Whether a DP interrupt has been raised that handle_dp_complete hasn't been called for yet.
+ * Has to be called with interrupts disabled, so that one can't be raised in between.
+ */
+static s32 dp_complete_pending(void) {
+    s32 i;
+
+    if (IO_READ(MI_INTR_REG) & MI_INTR_DP) {
+        return TRUE;
+    }
+    for (i = 0; i < gIntrMesgQueue.validCount; i++) {
+        if (gIntrMesgQueue.msg[(gIntrMesgQueue.first + i) % gIntrMesgQueue.msgCount] == (OSMesg) MESG_DP_COMPLETE) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+#endif
+
 void handle_sp_complete(void) {
     struct SPTask *curSPTask = gActiveSPTask;
 
@@ -285,9 +312,34 @@ void handle_sp_complete(void) {
 #endif
         }
     }
+#ifdef PUPPYPRINT_RDP_MARKERS
+    // The RDP may have finished the list before the RSP reported in, in which case
+    // its last interrupt was taken for a marker and there won't be another one.
+    // If a DP interrupt is still on its way, that one ends the task instead, so that
+    // it can't be taken for the end of the next task.
+    if (curSPTask == sCurrentDisplaySPTask && curSPTask->state == SPTASK_STATE_FINISHED) {
+        OSIntMask mask = osSetIntMask(OS_IM_NONE);
+        s32 ended = (puppyprint_rdp_idle() && !dp_complete_pending());
+
+        osSetIntMask(mask);
+        if (ended) {
+            handle_dp_complete();
+        }
+    }
+#endif
 }
 
 void handle_dp_complete(void) {
+#ifdef PUPPYPRINT_RDP_MARKERS
+    // A marker's interrupt can arrive after the task it belongs to has already finished.
+    if (sCurrentDisplaySPTask == NULL) {
+        return;
+    }
+    // The RDP reached a profiling marker, not the end of the task.
+    if (puppyprint_rdp_marker_reached(sCurrentDisplaySPTask)) {
+        return;
+    }
+#endif
     // Gfx SP task is completely done.
     if (sCurrentDisplaySPTask->msgqueue != NULL) {
         osSendMesg(sCurrentDisplaySPTask->msgqueue, sCurrentDisplaySPTask->msg, OS_MESG_NOBLOCK);
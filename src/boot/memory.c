@@ -464,6 +464,186 @@ void *load_segment_decompress_heap(u32 segment, u8 *srcStart, u8 *srcEnd) {
     return gDecompressionHeap;
 }
 
+#ifdef LEVEL_LOAD_PLANS
+// A read is split into at most this many blocks, so that other users of the PI can get in between them.
+#define LOAD_PLAN_MAX_BLOCKS 16
+
+static OSIoMesg sLoadPlanDmaMesgs[LOAD_PLAN_MAX_BLOCKS];
+static OSMesg sLoadPlanMesgBuf[LOAD_PLAN_MAX_BLOCKS];
+static OSMesgQueue sLoadPlanMesgQueue;
+static s32 sLoadPlanPendingBlocks = 0;
+
+/**
+ * Start a DMA read from ROM without waiting for it to finish, see load_plan_dma_wait.
+ */
+static void load_plan_dma_start(u8 *dest, u8 *srcStart, u8 *srcEnd) {
+    u32 size = ALIGN16(srcEnd - srcStart);
+    u32 blockSize = (ALIGN(size, (LOAD_PLAN_MAX_BLOCKS * 0x1000)) / LOAD_PLAN_MAX_BLOCKS);
+
+    osInvalDCache(dest, size);
+    while (size != 0) {
+        u32 copySize = (size >= blockSize) ? blockSize : size;
+
+        osPiStartDma(&sLoadPlanDmaMesgs[sLoadPlanPendingBlocks++], OS_MESG_PRI_NORMAL, OS_READ, (uintptr_t) srcStart, dest, copySize,
+                     &sLoadPlanMesgQueue);
+
+        dest += copySize;
+        srcStart += copySize;
+        size -= copySize;
+    }
+}
+
+static void load_plan_dma_wait(void) {
+#if PUPPYPRINT_DEBUG
+    OSTime first = osGetTime();
+#endif
+    while (sLoadPlanPendingBlocks > 0) {
+        osRecvMesg(&sLoadPlanMesgQueue, &gMainReceivedMesg, OS_MESG_BLOCK);
+        sLoadPlanPendingBlocks--;
+    }
+#if PUPPYPRINT_DEBUG
+    dmaTime[perfIteration] += (osGetTime() - first);
+#endif
+}
+
+/**
+ * Allocate the destination of a job and start reading it. Compressed jobs are
+ * read into the buffer that was allocated for them in load_plan_execute.
+ * Returns the block that was allocated from the left side of the pool, if any.
+ */
+static void *load_plan_start_job(struct LoadJob *job, u8 *compressed) {
+    void *addr = NULL;
+
+    if (job->type != LOAD_JOB_RAW) {
+        load_plan_dma_start(compressed, job->srcStart, job->srcEnd);
+    } else if (job->bssStart != NULL) {
+        // Same as load_segment, the code is aligned to a TLB page.
+        u32 offset = ALIGN(((uintptr_t)sPoolListHeadL + 16), TLB_PAGE_SIZE) - ((uintptr_t)sPoolListHeadL + 16);
+        u32 size = ALIGN16(job->srcEnd - job->srcStart);
+
+        addr = main_pool_alloc((offset + size + (job->bssEnd - job->bssStart)), MEMORY_POOL_LEFT);
+        load_plan_dma_start(((u8 *)addr + offset), job->srcStart, job->srcEnd);
+    } else {
+        addr = main_pool_alloc(ALIGN16(job->srcEnd - job->srcStart), MEMORY_POOL_LEFT);
+        load_plan_dma_start(addr, job->srcStart, job->srcEnd);
+    }
+
+    return addr;
+}
+
+static void load_plan_finish_raw_job(struct LoadJob *job, void *addr) {
+    if (job->bssStart != NULL) {
+        u8 *realAddr = (u8 *)ALIGN((uintptr_t)addr, TLB_PAGE_SIZE);
+        u32 size = ALIGN16(job->srcEnd - job->srcStart);
+
+        bzero((realAddr + size), (job->bssEnd - job->bssStart));
+        set_segment_base_addr(job->segment, realAddr);
+        mapTLBPages((job->segment << 24), VIRTUAL_TO_PHYSICAL(realAddr), ((job->srcEnd - job->srcStart) + (job->bssEnd - job->bssStart)), job->segment);
+    } else {
+        set_segment_base_addr(job->segment, addr);
+    }
+}
+
+static void load_plan_decompress(u8 *compressed, void *dest) {
+#if RNC1
+    Propack_UnpackM1(compressed, dest);
+#elif RNC2
+    Propack_UnpackM2(compressed, dest);
+#elif YAY0
+    slidstart(compressed, dest);
+#elif MIO0
+    decompress(compressed, dest);
+#endif
+}
+
+/**
+ * Load a run of segments, reading each segment from ROM while the one before
+ * it is being decompressed. The segments end up at the same addresses as when
+ * they are loaded one at a time with load_segment and load_segment_decompress.
+ * Returns FALSE without loading anything if the pool doesn't have room for
+ * every compressed segment at once, so the caller can load them one at a time.
+ */
+s32 load_plan_execute(struct LoadPlan *plan) {
+    u8 *compressed[LOAD_PLAN_MAX_JOBS];
+    u8 *firstCompressed = NULL;
+    u32 leftSize = 0;
+    void *addr;
+    s32 i;
+
+    // Every compressed segment gets its own buffer up front,
+    // since the right side of the pool can only free its newest block.
+    for (i = 0; i < plan->numJobs; i++) {
+        struct LoadJob *job = &plan->jobs[i];
+
+        compressed[i] = NULL;
+        if (job->type == LOAD_JOB_RAW) {
+            leftSize += (ALIGN16(job->srcEnd - job->srcStart) + ALIGN16(job->bssEnd - job->bssStart) + 16);
+            if (job->bssStart != NULL) {
+                leftSize += TLB_PAGE_SIZE;
+            }
+            continue;
+        }
+
+        compressed[i] = main_pool_alloc(ALIGN16(job->srcEnd - job->srcStart), MEMORY_POOL_RIGHT);
+        if (compressed[i] == NULL) {
+            break;
+        }
+        if (firstCompressed == NULL) {
+            firstCompressed = compressed[i];
+        }
+
+        // The size of a compressed segment is in its header.
+        if (job->type == LOAD_JOB_COMPRESSED) {
+            dma_read(compressed[i], job->srcStart, (job->srcStart + 16));
+            leftSize += (ALIGN16(*(u32 *)(compressed[i] + 4)) + 16);
+        }
+    }
+
+    if (i < plan->numJobs || leftSize > main_pool_available()) {
+        if (firstCompressed != NULL) {
+            main_pool_free(firstCompressed);
+        }
+        return FALSE;
+    }
+
+    osCreateMesgQueue(&sLoadPlanMesgQueue, sLoadPlanMesgBuf, ARRAY_COUNT(sLoadPlanMesgBuf));
+    addr = load_plan_start_job(&plan->jobs[0], compressed[0]);
+
+    for (i = 0; i < plan->numJobs; i++) {
+        struct LoadJob *job = &plan->jobs[i];
+
+        load_plan_dma_wait();
+        // Allocate this job's segment before the next job's, in the same order as the level script.
+        if (job->type == LOAD_JOB_COMPRESSED) {
+            addr = main_pool_alloc(*(u32 *)(compressed[i] + 4), MEMORY_POOL_LEFT);
+        } else if (job->type == LOAD_JOB_COMPRESSED_HEAP) {
+            addr = gDecompressionHeap;
+        }
+
+        void *nextAddr = NULL;
+        if ((i + 1) < plan->numJobs) {
+            nextAddr = load_plan_start_job(&plan->jobs[i + 1], compressed[i + 1]);
+        }
+
+        if (job->type == LOAD_JOB_RAW) {
+            load_plan_finish_raw_job(job, addr);
+        } else {
+            load_plan_decompress(compressed[i], addr);
+            set_segment_base_addr(job->segment, addr);
+        }
+#if PUPPYPRINT_DEBUG
+        ramsizeSegment[(job->segment + nameTable) - 2] = ((s32)job->srcEnd - (s32)job->srcStart);
+#endif
+        addr = nextAddr;
+    }
+
+    if (firstCompressed != NULL) {
+        main_pool_free(firstCompressed);
+    }
+    return TRUE;
+}
+#endif
+
 void load_engine_code_segment(void) {
     void *startAddr = (void *) _engineSegmentStart;
     u32 totalSize = _engineSegmentEnd - _engineSegmentStart;
@@ -0,0 +1,267 @@
+// Checks that the gfx task ends exactly once, on the right interrupt, with PUPPYPRINT_RDP_MARKERS.
+// Build and run from this directory:
+// FLAGS="-w -D_LANGUAGE_C -DF3DEX_GBI_2 -DVERSION_US -DNON_MATCHING -DAVOID_UB -include scheduler_config.h
+//     -I../../../include -I../../../include/n64 -I../../../include/hvqm -I../.. -I../../.. -I../../../build/us"
+// gcc $FLAGS -ffunction-sections -fdata-sections -Wl,--gc-sections scheduler.c -o scheduler && ./scheduler
+// The RCP registers are faked by mapping memory where the N64 keeps them.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "../main.c"
+#include "../../game/puppyprint_rdp.c"
+
+#define REG(addr) (*(vu32 *) (uintptr_t) PHYS_TO_K1(addr))
+
+struct GfxPool gGfxPools[2];
+struct GfxPool *gGfxPool = &gGfxPools[0];
+Gfx *gDisplayListHead;
+
+void puppyprint_render_rdp_layers(void) {}
+struct PuppyPrintPage ppPages[] = {
+    {&puppyprint_render_rdp_layers, "RDP Layers"},
+};
+u8 fDebug;
+u8 sPPDebugPage;
+s8 perfIteration;
+u32 rspDelta;
+u32 rspGenTime[NUM_PERF_ITERATIONS + 1];
+void profiler_update(UNUSED u32 *time, UNUSED OSTime time2) {}
+u32  rdpSegmentBusyTime[RDP_SEGMENT_COUNT][NUM_PERF_ITERATIONS + 1];
+u32 rdpSegmentTotalTime[RDP_SEGMENT_COUNT][NUM_PERF_ITERATIONS + 1];
+
+static OSMesgQueue sGfxDoneQueue;
+static OSMesg sGfxDoneBuf[8];
+static int sFailures;
+
+/* libultra stand-ins */
+
+void osCreateMesgQueue(OSMesgQueue *mq, OSMesg *msg, s32 count) {
+    memset(mq, 0, sizeof(*mq));
+    mq->msg = msg;
+    mq->msgCount = count;
+}
+
+s32 osSendMesg(OSMesgQueue *mq, OSMesg msg, UNUSED s32 flag) {
+    if (mq->validCount >= mq->msgCount) {
+        return -1;
+    }
+    mq->msg[(mq->first + mq->validCount) % mq->msgCount] = msg;
+    mq->validCount++;
+    return 0;
+}
+
+s32 osRecvMesg(OSMesgQueue *mq, OSMesg *msg, UNUSED s32 flag) {
+    if (mq->validCount == 0) {
+        return -1;
+    }
+    *msg = mq->msg[mq->first];
+    mq->first = (mq->first + 1) % mq->msgCount;
+    mq->validCount--;
+    return 0;
+}
+
+OSIntMask osSetIntMask(OSIntMask mask) { return mask; }
+void osSpTaskLoad(UNUSED OSTask *task) {}
+void osSpTaskStartGo(UNUSED OSTask *task) {}
+void osSpTaskYield(void) {}
+OSYieldResult osSpTaskYielded(UNUSED OSTask *task) { return 0; }
+void osWritebackDCacheAll(void) {}
+OSTime osGetTime(void) { return 0; }
+
+/* Fake RCP */
+
+static void rdp_start(void) {
+    REG(DPC_STATUS_REG)  = DPC_STATUS_CMD_BUSY | DPC_STATUS_PIPE_BUSY;
+    REG(DPC_CURRENT_REG) = 0;
+    REG(DPC_END_REG)     = 0x100;
+}
+
+static void rdp_finish(void) {
+    REG(DPC_STATUS_REG)  = 0;
+    REG(DPC_CURRENT_REG) = REG(DPC_END_REG);
+}
+
+// The interrupt has been raised, but the OS hasn't passed it on yet.
+static void raise_dp(void) {
+    REG(MI_INTR_REG) |= MI_INTR_DP;
+}
+
+static void os_handle_interrupts(void) {
+    if (REG(MI_INTR_REG) & MI_INTR_DP) {
+        REG(MI_INTR_REG) &= ~MI_INTR_DP;
+        osSendMesg(&gIntrMesgQueue, (OSMesg) MESG_DP_COMPLETE, OS_MESG_NOBLOCK);
+    }
+}
+
+static void send(uintptr_t msg) {
+    osSendMesg(&gIntrMesgQueue, (OSMesg) msg, OS_MESG_NOBLOCK);
+}
+
+// Same as the loop in thread3_main.
+static void run_scheduler(void) {
+    OSMesg msg;
+
+    os_handle_interrupts();
+    while (osRecvMesg(&gIntrMesgQueue, &msg, OS_MESG_NOBLOCK) == 0) {
+        switch ((uintptr_t) msg) {
+            case MESG_VI_VBLANK:        handle_vblank();      break;
+            case MESG_SP_COMPLETE:      handle_sp_complete(); break;
+            case MESG_DP_COMPLETE:      handle_dp_complete(); break;
+            case MESG_START_GFX_SPTASK: start_gfx_sptask();   break;
+        }
+        os_handle_interrupts();
+    }
+}
+
+/* Test setup */
+
+static void reset(s32 profilerOpen) {
+    osCreateMesgQueue(&gIntrMesgQueue, gIntrMesgBuf, ARRAY_COUNT(gIntrMesgBuf));
+    osCreateMesgQueue(&sGfxDoneQueue, sGfxDoneBuf, ARRAY_COUNT(sGfxDoneBuf));
+    gActiveSPTask = sCurrentAudioSPTask = sNextAudioSPTask = NULL;
+    sCurrentDisplaySPTask = sNextDisplaySPTask = NULL;
+    REG(MI_INTR_REG) = 0;
+    rdp_finish();
+
+    fDebug = profilerOpen;
+}
+
+static struct SPTask *submit(s32 pool, s32 numMarkers) {
+    static Gfx buf[RDP_SEGMENT_COUNT];
+    struct SPTask *task = &gGfxPools[pool].spTask;
+    s32 i;
+
+    gGfxPool = &gGfxPools[pool];
+    gDisplayListHead = buf;
+    puppyprint_rdp_markers_reset();
+    for (i = 0; i < numMarkers; i++) {
+        puppyprint_rdp_marker(RDP_SEGMENT_BACKGROUND);
+    }
+
+    task->task.t.type = M_GFXTASK;
+    task->msgqueue = &sGfxDoneQueue;
+    task->msg = (OSMesg) (uintptr_t) (pool + 1);
+    exec_display_list(task);
+    return task;
+}
+
+static void expect(const char *test, const char *what, s32 value, s32 expected) {
+    if (value != expected) {
+        printf("%s: %s is %d, expected %d\n", test, what, value, expected);
+        sFailures++;
+    }
+}
+
+/* Interrupt orderings */
+
+// The RSP finishes first, then the RDP.
+static void test_in_order(s32 profilerOpen) {
+    const char *name = profilerOpen ? "in order, profiler open" : "in order";
+    struct SPTask *task;
+
+    reset(profilerOpen);
+    task = submit(0, 2);
+    run_scheduler();
+    rdp_start();
+    // The markers are only inserted while the profiler is open.
+    if (profilerOpen) {
+        raise_dp();
+        run_scheduler();
+    }
+    send(MESG_SP_COMPLETE);
+    run_scheduler();
+    expect(name, "state after the SP interrupt", task->state, SPTASK_STATE_FINISHED);
+    if (profilerOpen) {
+        raise_dp();
+        run_scheduler();
+    }
+    rdp_finish();
+    raise_dp();
+    run_scheduler();
+    expect(name, "state", task->state, SPTASK_STATE_FINISHED_DP);
+    expect(name, "done messages", sGfxDoneQueue.validCount, 1);
+}
+
+// Two markers are reached before the OS passes on their interrupt, so there is one fewer,
+// and the last interrupt comes before the RSP is done. handle_sp_complete has to end the task.
+static void test_merged_markers(void) {
+    const char *name = "merged markers";
+    struct SPTask *task;
+
+    reset(TRUE);
+    task = submit(0, 2);
+    run_scheduler();
+    rdp_start();
+    raise_dp();
+    run_scheduler();
+    rdp_finish();
+    raise_dp();
+    run_scheduler();
+    expect(name, "state before the SP interrupt", task->state, SPTASK_STATE_RUNNING);
+    send(MESG_SP_COMPLETE);
+    run_scheduler();
+    expect(name, "state", task->state, SPTASK_STATE_FINISHED_DP);
+    expect(name, "done messages", sGfxDoneQueue.validCount, 1);
+}
+
+// The RDP is done when the RSP reports in, but its interrupt is still on its way.
+// That interrupt must end the task, not the one after it.
+static void test_late_dp(s32 profilerOpen, s32 queued) {
+    char name[64];
+    struct SPTask *task, *next;
+
+    sprintf(name, "late DP interrupt%s%s", queued ? " queued" : "", profilerOpen ? ", profiler open" : "");
+    reset(profilerOpen);
+    task = submit(0, 0);
+    run_scheduler();
+    rdp_start();
+    rdp_finish();
+    if (queued) {
+        send(MESG_SP_COMPLETE);
+        send(MESG_DP_COMPLETE);
+        handle_sp_complete();
+        expect(name, "state after the SP interrupt", task->state, SPTASK_STATE_FINISHED);
+        // Drop the SP message that was just handled by hand, the DP one stays queued.
+        gIntrMesgQueue.first = (gIntrMesgQueue.first + 1) % gIntrMesgQueue.msgCount;
+        gIntrMesgQueue.validCount--;
+    } else {
+        raise_dp();
+        handle_sp_complete();
+        expect(name, "state after the SP interrupt", task->state, SPTASK_STATE_FINISHED);
+    }
+
+    next = submit(1, 0);
+    send(MESG_VI_VBLANK);
+    run_scheduler();
+    expect(name, "state", task->state, SPTASK_STATE_FINISHED_DP);
+    expect(name, "done messages", sGfxDoneQueue.validCount, 1);
+    send(MESG_VI_VBLANK);
+    run_scheduler();
+    expect(name, "next task's state", next->state, SPTASK_STATE_RUNNING);
+    expect(name, "current task is the next one", sCurrentDisplaySPTask == next, TRUE);
+}
+
+int main(void) {
+    void *regs = mmap((void *) (uintptr_t) PHYS_TO_K1(SP_BASE_REG), 0x400000, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (regs == MAP_FAILED) {
+        printf("Couldn't map the RCP registers\n");
+        return 1;
+    }
+
+    test_in_order(FALSE);
+    test_in_order(TRUE);
+    test_merged_markers();
+    test_late_dp(FALSE, FALSE);
+    test_late_dp(FALSE, TRUE);
+    test_late_dp(TRUE, FALSE);
+    test_late_dp(TRUE, TRUE);
+
+    if (sFailures == 0) {
+        printf("OK\n");
+    }
+    return (sFailures != 0);
+}
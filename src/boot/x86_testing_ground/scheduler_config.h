@@ -0,0 +1,7 @@
+// Config for building scheduler.c on the host, included with -include.
+// config_debug.h is only read once, so DISABLE_ALL can be taken back before config_safeguards.h sees it.
+#include "config/config_debug.h"
+
+#undef DISABLE_ALL
+#define PUPPYPRINT_DEBUG 1
+#define PUPPYPRINT_RDP_MARKERS
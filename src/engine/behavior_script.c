@@ -104,7 +104,7 @@ static s32 bhv_cmd_billboard(void) {
 static s32 bhv_cmd_set_model(void) {
     ModelID32 modelID = BHV_CMD_GET_2ND_S16(0);
 
-    gCurrentObject->header.gfx.sharedChild = gLoadedGraphNodes[modelID];
+    gCurrentObject->header.gfx.sharedChild = get_loaded_graph_node(modelID);
 
     gCurBhvCommand++;
     return BHV_PROC_CONTINUE;
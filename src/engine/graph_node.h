@@ -181,6 +181,29 @@ struct DisplayListNode {
     struct DisplayListNode *next;
 };
 
+#ifdef TRANSPARENT_OBJECT_BATCHING
+/** A model split into one display list per material, so that every instance
+ *  of it on a layer can be drawn while setting up each material only once.
+ *  The instance's opacity is passed in the environment color's alpha.
+ */
+struct DisplayListBatch {
+    const Gfx *const *materials; // Sets up each material, drawn once per layer.
+    const Gfx *const *geometry;  // The triangles using each material, drawn once per instance.
+    const Gfx *end;              // Resets the state changed by the materials.
+    s32 numMaterials;
+};
+
+/** An instance of a display list batch in the master list.
+ */
+struct DisplayListBatchInstance {
+    Mtx *transform;
+    const struct DisplayListBatch *batch;
+    struct DisplayListBatchInstance *next;
+    u8 alpha;
+    u8 dither;
+};
+#endif
+
 /** GraphNode that manages the 8 top-level display lists that will be drawn
  *  Each list has its own render mode, so for example water is drawn in a
  *  different master list than opaque objects.
@@ -190,6 +213,9 @@ struct GraphNodeMasterList {
     /*0x00*/ struct GraphNode node;
     /*0x14*/ struct DisplayListNode *listHeads[GRAPH_NODE_NUM_UCODES][LAYER_COUNT];
     /*0x34*/ struct DisplayListNode *listTails[GRAPH_NODE_NUM_UCODES][LAYER_COUNT];
+#ifdef TRANSPARENT_OBJECT_BATCHING
+    /*0x54*/ struct DisplayListBatchInstance *batchHeads[GRAPH_NODE_NUM_UCODES][LAYER_COUNT];
+#endif
 };
 
 /** Simply used as a parent to group multiple children.
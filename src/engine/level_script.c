@@ -9,6 +9,7 @@
 #include "buffers/zbuffer.h"
 #include "game/area.h"
 #include "game/game_init.h"
+#include "game/macro_special_objects.h"
 #include "game/mario.h"
 #include "game/memory.h"
 #include "game/object_helpers.h"
@@ -55,6 +56,19 @@ static uintptr_t sStack[NUM_TLB_SEGMENTS];
 
 static struct AllocOnlyPool *sLevelPool = NULL;
 
+#ifdef LAZY_MODEL_LOADING
+// The geo layouts of models loaded with LOAD_MODEL_FROM_GEO, built by get_loaded_graph_node.
+static const GeoLayout *sModelGeoLayouts[MODEL_ID_COUNT];
+// The geo layouts of models loaded outside of a level, put back when the level is cleared.
+static const GeoLayout *sGlobalModelGeoLayouts[MODEL_ID_COUNT];
+// The number of model graphs built since the level was loaded, the RAM they take up and the time it took, for profiling.
+s32 gNumModelsBuilt = 0;
+u32 gModelGraphsSize = 0;
+OSTime gModelBuildTime = 0;
+// The number of model graphs that couldn't be built for lack of memory since the level was loaded.
+static s32 sNumModelBuildFailures = 0;
+#endif
+
 static u16 sDelayFrames = 0;
 static u16 sDelayFrames2 = 0;
 
@@ -281,13 +295,78 @@ static void level_cmd_load_to_fixed_address(void) {
     sCurrentCmd = CMD_NEXT;
 }
 
+#ifdef LEVEL_LOAD_PLANS
+static s32 get_load_job_type(u8 cmdType) {
+    switch (cmdType) {
+        case LEVEL_CMD_LOAD_RAW:          return LOAD_JOB_RAW;
+        case LEVEL_CMD_LOAD_YAY0:         return LOAD_JOB_COMPRESSED;
+        case LEVEL_CMD_LOAD_YAY0_TEXTURE: return LOAD_JOB_COMPRESSED_HEAP;
+    }
+    return -1;
+}
+
+/**
+ * Gather the load commands that follow each other from the current one into a
+ * load plan, so that reading each segment from ROM overlaps with decompressing
+ * the one before it. Returns FALSE if there is nothing to overlap with or the
+ * plan doesn't fit in the pool, in which case the current command loads its
+ * segment on its own.
+ */
+static s32 level_script_run_load_plan(void) {
+    struct LevelCommand *firstCmd = sCurrentCmd;
+    struct LoadPlan plan;
+    s32 type;
+
+    plan.numJobs = 0;
+    while (plan.numJobs < LOAD_PLAN_MAX_JOBS) {
+        struct LoadJob *job = &plan.jobs[plan.numJobs];
+
+        type = get_load_job_type(sCurrentCmd->type);
+        if (type < 0) {
+            break;
+        }
+
+        job->type     = type;
+        job->segment  = CMD_GET(s16, 2);
+        job->srcStart = CMD_GET(void *, 4);
+        job->srcEnd   = CMD_GET(void *, 8);
+        job->bssStart = NULL;
+        job->bssEnd   = NULL;
+        if (type == LOAD_JOB_RAW) {
+            job->bssStart = CMD_GET(void *, 12);
+            job->bssEnd   = CMD_GET(void *, 16);
+        }
+
+        plan.numJobs++;
+        sCurrentCmd = CMD_NEXT;
+    }
+
+    if (plan.numJobs < 2 || !load_plan_execute(&plan)) {
+        sCurrentCmd = firstCmd;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+#endif
+
 static void level_cmd_load_raw(void) {
+#ifdef LEVEL_LOAD_PLANS
+    if (level_script_run_load_plan()) {
+        return;
+    }
+#endif
     load_segment(CMD_GET(s16, 2), CMD_GET(void *, 4), CMD_GET(void *, 8),
             MEMORY_POOL_LEFT, CMD_GET(void *, 12), CMD_GET(void *, 16));
     sCurrentCmd = CMD_NEXT;
 }
 
 static void level_cmd_load_yay0(void) {
+#ifdef LEVEL_LOAD_PLANS
+    if (level_script_run_load_plan()) {
+        return;
+    }
+#endif
     load_segment_decompress(CMD_GET(s16, 2), CMD_GET(void *, 4), CMD_GET(void *, 8));
     sCurrentCmd = CMD_NEXT;
 }
@@ -308,6 +387,11 @@ static void level_cmd_load_mario_head(void) {
 }
 
 static void level_cmd_load_yay0_texture(void) {
+#ifdef LEVEL_LOAD_PLANS
+    if (level_script_run_load_plan()) {
+        return;
+    }
+#endif
     load_segment_decompress_heap(CMD_GET(s16, 2), CMD_GET(void *, 4), CMD_GET(void *, 8));
     sCurrentCmd = CMD_NEXT;
 }
@@ -324,6 +408,9 @@ static void level_cmd_init_level(void) {
     clear_objects();
     clear_areas();
     main_pool_push_state();
+#ifdef LAZY_MODEL_LOADING
+    memcpy(sGlobalModelGeoLayouts, sModelGeoLayouts, sizeof(sModelGeoLayouts));
+#endif
     for (u8 clearPointers = 0; clearPointers < AREA_COUNT; clearPointers++) {
         gAreaSkyboxStart[clearPointers] = 0;
         gAreaSkyboxEnd[clearPointers] = 0;
@@ -355,11 +442,145 @@ void unmap_tlbs(void) {
     }
 }
 
+#ifdef LAZY_MODEL_LOADING
+/**
+ * Return the graph of a model that has already been built with the same geo layout, if any.
+ */
+static struct GraphNode *find_model_graph_node(const GeoLayout *geo) {
+    s32 i;
+
+    for (i = 0; i < MODEL_ID_COUNT; i++) {
+        if (sModelGeoLayouts[i] == geo && gLoadedGraphNodes[i] != NULL) {
+            return gLoadedGraphNodes[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Return the graph of a model, building it first if it was loaded with LOAD_MODEL_FROM_GEO
+ * and hasn't been used yet. Every model ID with the same geo layout shares its graph.
+ * The graph is built in the level pool while the level is loading, and in its own pool
+ * from the main pool afterwards. Returns NULL if there isn't enough memory left.
+ */
+struct GraphNode *get_loaded_graph_node(ModelID32 model) {
+    struct GraphNode *node = gLoadedGraphNodes[model];
+    const GeoLayout *geo = sModelGeoLayouts[model];
+    s32 i;
+
+    if (node != NULL || geo == NULL) {
+        return node;
+    }
+
+    OSTime startTime = osGetTime();
+
+    if (sLevelPool != NULL) {
+        u32 usedSpace = sLevelPool->usedSpace;
+
+        node = process_geo_layout(sLevelPool, (void *) geo);
+        gModelGraphsSize += (sLevelPool->usedSpace - usedSpace);
+    } else {
+        // The display list heap takes up the rest of the main pool while the scene is processed.
+        struct AllocOnlyPool *pool = NULL;
+
+        if (main_pool_available() > sizeof(struct AllocOnlyPool)) {
+            pool = alloc_only_pool_init(main_pool_available() - sizeof(struct AllocOnlyPool), MEMORY_POOL_LEFT);
+        }
+
+        if (pool != NULL) {
+            node = process_geo_layout(pool, (void *) geo);
+            alloc_only_pool_resize(pool, pool->usedSpace);
+            gModelGraphsSize += (pool->usedSpace + sizeof(struct AllocOnlyPool));
+        }
+    }
+
+    if (node == NULL) {
+        sNumModelBuildFailures++;
+#if PUPPYPRINT_DEBUG
+        append_puppyprint_log("Model %d couldn't be built.", model);
+#endif
+        return NULL;
+    }
+
+    gModelBuildTime += (osGetTime() - startTime);
+    gNumModelsBuilt++;
+
+    for (i = 0; i < MODEL_ID_COUNT; i++) {
+        if (sModelGeoLayouts[i] == geo) {
+            gLoadedGraphNodes[i] = node;
+        }
+    }
+
+    return node;
+}
+
+/**
+ * Return whether a graph is the one used by a model. Models that haven't been built yet
+ * aren't used by any object, not even by objects without a model.
+ */
+s32 model_uses_graph_node(ModelID32 model, struct GraphNode *node) {
+    if (gLoadedGraphNodes[model] == NULL && sModelGeoLayouts[model] != NULL) {
+        return FALSE;
+    }
+
+    return (gLoadedGraphNodes[model] == node);
+}
+
+/**
+ * Build the models of the macro and special objects in every area while the level pool is still there,
+ * rather than in the main pool once the area loads, and report any that couldn't be built.
+ * Models of objects spawned later on are still built the first time they're used.
+ */
+static void build_area_object_models(void) {
+    s32 i;
+
+    for (i = 0; i < AREA_COUNT; i++) {
+        if (gAreaData[i].terrainData != NULL) {
+            build_area_terrain_object_models(gAreaData[i].terrainData);
+        }
+        if (gAreaData[i].macroObjects != NULL) {
+            build_macro_object_models(gAreaData[i].macroObjects);
+        }
+    }
+
+#if PUPPYPRINT_DEBUG
+    if (sNumModelBuildFailures != 0) {
+        append_puppyprint_log("%d models couldn't be built while loading.", sNumModelBuildFailures);
+    }
+#endif
+}
+
+/**
+ * The graphs built by get_loaded_graph_node are freed along with the level,
+ * so they have to be built again the next time the model is used. The geo layouts
+ * the level loaded go away with it, while models loaded outside of it are kept.
+ */
+static void clear_model_graph_nodes(void) {
+    s32 i;
+
+    for (i = 0; i < MODEL_ID_COUNT; i++) {
+        if (sModelGeoLayouts[i] != NULL || sGlobalModelGeoLayouts[i] != NULL) {
+            gLoadedGraphNodes[i] = NULL;
+        }
+        sModelGeoLayouts[i] = sGlobalModelGeoLayouts[i];
+    }
+
+    gNumModelsBuilt = 0;
+    gModelGraphsSize = 0;
+    gModelBuildTime = 0;
+    sNumModelBuildFailures = 0;
+}
+#endif
+
 static void level_cmd_clear_level(void) {
     clear_objects();
     clear_area_graph_nodes();
     clear_areas();
     main_pool_pop_state();
+#ifdef LAZY_MODEL_LOADING
+    clear_model_graph_nodes();
+#endif
     unmap_tlbs();
 
     sCurrentCmd = CMD_NEXT;
@@ -377,6 +598,9 @@ static void level_cmd_alloc_level_pool(void) {
 static void level_cmd_free_level_pool(void) {
     s32 i;
 
+#ifdef LAZY_MODEL_LOADING
+    build_area_object_models();
+#endif
     alloc_only_pool_resize(sLevelPool, sLevelPool->usedSpace);
     sLevelPool = NULL;
 
@@ -426,6 +650,9 @@ static void level_cmd_load_model_from_dl(void) {
     if (model < MODEL_ID_COUNT) {
         gLoadedGraphNodes[model] =
             (struct GraphNode *) init_graph_node_display_list(sLevelPool, 0, layer, dl_ptr);
+#ifdef LAZY_MODEL_LOADING
+        sModelGeoLayouts[model] = NULL;
+#endif
     }
 
     sCurrentCmd = CMD_NEXT;
@@ -436,7 +663,12 @@ static void level_cmd_load_model_from_geo(void) {
     void *geo = CMD_GET(void *, 4);
 
     if (model < MODEL_ID_COUNT) {
+#ifdef LAZY_MODEL_LOADING
+        sModelGeoLayouts[model] = geo;
+        gLoadedGraphNodes[model] = find_model_graph_node(geo);
+#else
         gLoadedGraphNodes[model] = process_geo_layout(sLevelPool, geo);
+#endif
     }
 
     sCurrentCmd = CMD_NEXT;
@@ -453,6 +685,9 @@ static void level_cmd_23(void) {
         // is being stored to the array, so cast the pointer.
         gLoadedGraphNodes[model] =
             (struct GraphNode *) init_graph_node_scale(sLevelPool, 0, layer, dl, scale);
+#ifdef LAZY_MODEL_LOADING
+        sModelGeoLayouts[model] = NULL;
+#endif
     }
 
     sCurrentCmd = CMD_NEXT;
@@ -466,7 +701,7 @@ static void level_cmd_init_mario(void) {
     gMarioSpawnInfo->areaIndex = 0;
     gMarioSpawnInfo->behaviorArg = CMD_GET(u32, 4);
     gMarioSpawnInfo->behaviorScript = CMD_GET(void *, 8);
-    gMarioSpawnInfo->model = gLoadedGraphNodes[CMD_GET(ModelID16, 0x2)]; // u8, 3?
+    gMarioSpawnInfo->model = get_loaded_graph_node(CMD_GET(ModelID16, 0x2)); // u8, 3?
     gMarioSpawnInfo->next = NULL;
 
     sCurrentCmd = CMD_NEXT;
@@ -493,7 +728,7 @@ static void level_cmd_place_object(void) {
 
         spawnInfo->behaviorArg = CMD_GET(u32, 16);
         spawnInfo->behaviorScript = CMD_GET(void *, 20);
-        spawnInfo->model = gLoadedGraphNodes[model];
+        spawnInfo->model = get_loaded_graph_node(model);
         spawnInfo->next = gAreas[sCurrAreaIndex].objectSpawnInfos;
 
         gAreas[sCurrAreaIndex].objectSpawnInfos = spawnInfo;
@@ -955,7 +1190,11 @@ struct LevelCommand *level_script_execute(struct LevelCommand *cmd) {
         LevelScriptJumpTable[sCurrentCmd->type]();
     }
 
+#ifdef FROZEN_PAUSE_FRAME
+    init_rcp(keep_frozen_frame() ? KEEP_ZBUFFER : CLEAR_ZBUFFER);
+#else
     init_rcp(CLEAR_ZBUFFER);
+#endif
     render_game();
     end_master_display_list();
     alloc_display_list(0);
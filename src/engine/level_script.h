@@ -3,10 +3,18 @@
 
 #include <PR/ultratypes.h>
 
+#include "types.h"
+
 struct LevelCommand;
 
 extern LevelScript level_script_entry[];
 
+#ifdef LAZY_MODEL_LOADING
+extern s32 gNumModelsBuilt;
+extern u32 gModelGraphsSize;
+extern OSTime gModelBuildTime;
+#endif
+
 struct LevelCommand *level_script_execute(struct LevelCommand *cmd);
 
 #endif // LEVEL_SCRIPT_H
@@ -214,6 +214,104 @@ s32 find_wall_collisions(struct WallCollisionData *colData) {
     return numCollisions;
 }
 
+#ifdef WALL_CLEARANCE_CACHE
+/**
+ * Find a lower bound for the distance from pos to every wall in the list, using the
+ * distance to the wall's plane and the height above or below it. Walls that are further
+ * away than the radius of a wall check are skipped by find_wall_collisions_from_list.
+ */
+static f32 find_wall_clearance_from_list(struct SurfaceNode *surfaceNode, Vec3f pos) {
+    register struct Surface *surf;
+    register f32 dist;
+    f32 clearance = CELL_SIZE;
+
+    while (surfaceNode != NULL) {
+        surf        = surfaceNode->surface;
+        surfaceNode = surfaceNode->next;
+
+        dist = absf((surf->normal.x * pos[0]) + (surf->normal.y * pos[1]) + (surf->normal.z * pos[2]) + surf->originOffset);
+
+        if (pos[1] < surf->lowerY) {
+            dist = MAX(dist, (surf->lowerY - pos[1]));
+        } else if (pos[1] > surf->upperY) {
+            dist = MAX(dist, (pos[1] - surf->upperY));
+        }
+
+        if (dist < clearance) {
+            clearance = dist;
+        }
+    }
+
+    return clearance;
+}
+
+/**
+ * Same as find_wall_collisions, but the level's walls are only checked when the position
+ * has moved further than the clearance measured at the last check, or into another cell.
+ * Walls belonging to objects are checked every time, since they can move on their own.
+ */
+s32 find_wall_collisions_with_clearance(struct WallCollisionData *colData, struct WallClearance *clearance) {
+    struct SurfaceNode *node;
+    s32 numCollisions = 0;
+    s32 x = colData->x;
+    s32 z = colData->z;
+    Vec3f pos = { colData->x, (colData->y + colData->offsetY), colData->z };
+
+    if (gCollisionFlags != COLLISION_FLAGS_NONE || is_outside_level_bounds(x, z)) {
+        clearance->dist = 0.0f;
+        return find_wall_collisions(colData);
+    }
+
+#if PUPPYPRINT_DEBUG
+    OSTime first = osGetTime();
+#endif
+
+    colData->numWalls = 0;
+
+    s32 cellX = GET_CELL_COORD(x);
+    s32 cellZ = GET_CELL_COORD(z);
+
+    node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS].next;
+    numCollisions += find_wall_collisions_from_list(node, colData);
+
+    // A wall push from an object can move the position towards the level's walls, so always check them then.
+    if (numCollisions == 0 && clearance->dist > 0.0f && clearance->cellX == cellX && clearance->cellZ == cellZ) {
+        f32 moved = absf(pos[0] - clearance->pos[0]) + absf(pos[1] - clearance->pos[1]) + absf(pos[2] - clearance->pos[2]);
+        if ((moved + colData->radius + 1.0f) < clearance->dist) {
+            goto done;
+        }
+    }
+
+    node = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS].next;
+    clearance->dist = 0.0f;
+
+    if (numCollisions == 0) {
+        // Measuring the clearance is cheaper than the full check, which can be skipped if no wall is in range.
+        f32 dist = find_wall_clearance_from_list(node, pos);
+        if ((colData->radius + 1.0f) < dist) {
+            vec3f_copy(clearance->pos, pos);
+            clearance->dist  = dist;
+            clearance->cellX = cellX;
+            clearance->cellZ = cellZ;
+            goto done;
+        }
+    }
+
+    numCollisions += find_wall_collisions_from_list(node, colData);
+
+done:
+#ifdef VANILLA_DEBUG
+    // Increment the debug tracker.
+    gNumCalls.wall++;
+#endif
+#if PUPPYPRINT_DEBUG
+    collisionTime[perfIteration] += osGetTime() - first;
+#endif
+
+    return numCollisions;
+}
+#endif
+
 /**
  * Collides with walls and returns the most recent wall.
  */
@@ -390,23 +488,22 @@ f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil) {
  *                     FLOORS                     *
  **************************************************/
 
-static s32 check_within_floor_triangle_bounds(s32 x, s32 z, struct Surface *surf) {
-    Vec3i vx, vz;
-    vx[0] = surf->vertex1[0];
-    vz[0] = surf->vertex1[2];
-    vx[1] = surf->vertex2[0];
-    vz[1] = surf->vertex2[2];
-
-    if (((vz[0] - z) * (vx[1] - vx[0]) - (vx[0] - x) * (vz[1] - vz[0])) < 0) return FALSE;
-
-    vx[2] = surf->vertex3[0];
-    vz[2] = surf->vertex3[2];
-
-    if (((vz[1] - z) * (vx[2] - vx[1]) - (vx[1] - x) * (vz[2] - vz[1])) < 0) return FALSE;
-    if (((vz[2] - z) * (vx[0] - vx[2]) - (vx[2] - x) * (vz[0] - vz[2])) < 0) return FALSE;
+/**
+ * Check that the point is within a floor triangle, given the X and Z of its vertices.
+ */
+ALWAYS_INLINE static s32 check_within_triangle_bounds_xz(s32 x, s32 z, s32 x1, s32 z1, s32 x2, s32 z2, s32 x3, s32 z3) {
+    if (((z1 - z) * (x2 - x1) - (x1 - x) * (z2 - z1)) < 0) return FALSE;
+    if (((z2 - z) * (x3 - x2) - (x2 - x) * (z3 - z2)) < 0) return FALSE;
+    if (((z3 - z) * (x1 - x3) - (x3 - x) * (z1 - z3)) < 0) return FALSE;
     return TRUE;
 }
 
+static s32 check_within_floor_triangle_bounds(s32 x, s32 z, struct Surface *surf) {
+    return check_within_triangle_bounds_xz(x, z, surf->vertex1[0], surf->vertex1[2],
+                                                 surf->vertex2[0], surf->vertex2[2],
+                                                 surf->vertex3[0], surf->vertex3[2]);
+}
+
 /**
  * Iterate through the list of floors and find the first floor under a given point.
  */
@@ -463,6 +560,71 @@ static struct Surface *find_floor_from_list(struct SurfaceNode *surfaceNode, s32
     return floor;
 }
 
+#ifdef COMPACT_STATIC_FLOORS
+static s32 check_within_compact_floor_bounds(s32 x, s32 z, struct CompactFloor *compactFloor) {
+    return check_within_triangle_bounds_xz(x, z, compactFloor->vertices[0][0], compactFloor->vertices[0][1],
+                                                 compactFloor->vertices[1][0], compactFloor->vertices[1][1],
+                                                 compactFloor->vertices[2][0], compactFloor->vertices[2][1]);
+}
+
+/**
+ * Same as find_floor_from_list, for the static floors of a cell in gCompactFloors.
+ * The full surface is only read once the point is known to be within the floor's bounds.
+ */
+static struct Surface *find_floor_from_compact_list(s32 cell, s32 x, s32 y, s32 z, f32 *pheight) {
+    register struct CompactFloor *compactFloor = &gCompactFloors[gCompactFloorCells[cell]];
+    register struct CompactFloor *end = &gCompactFloors[gCompactFloorCells[cell + 1]];
+    register struct Surface *surf, *floor = NULL;
+    register SurfaceType type = SURFACE_DEFAULT;
+    register f32 height;
+    register s32 bufferY = y + FIND_FLOOR_BUFFER;
+
+    for (; compactFloor < end; compactFloor++) {
+        // Exclude all floors above the point.
+        if (bufferY < compactFloor->lowerY) continue;
+        // Check that the point is within the triangle bounds.
+        if (!check_within_compact_floor_bounds(x, z, compactFloor)) continue;
+
+        surf = &sSurfacePool[compactFloor->surface & COMPACT_FLOOR_INDEX_MASK];
+
+        // Intangible and camera only floors, and floors the camera ignores, see find_floor_from_list.
+        if (compactFloor->surface & COMPACT_FLOOR_FILTERED) {
+            type = surf->type;
+
+            if (!(gCollisionFlags & COLLISION_FLAG_INCLUDE_INTANGIBLE) && (type == SURFACE_INTANGIBLE)) {
+                continue;
+            }
+
+            if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
+                if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
+                    continue;
+                }
+            } else if (type == SURFACE_CAMERA_BOUNDARY) {
+                continue;
+            }
+        }
+
+        // Get the height of the floor under the current location.
+        height = get_surface_height_at_location(x, z, surf);
+
+        // Exclude floors lower than the previous highest floor.
+        if (height < *pheight) continue;
+
+        // Checks for floor interaction with a FIND_FLOOR_BUFFER unit buffer.
+        if (bufferY < height) continue;
+
+        // Use the current floor
+        *pheight = height;
+        floor = surf;
+
+        // Exit the loop if it's not possible for another floor to be closer
+        // to the original point, or if COLLISION_FLAG_RETURN_FIRST.
+        if ((height == bufferY) || (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST)) break;
+    }
+    return floor;
+}
+#endif
+
 // Generic triangle bounds func
 ALWAYS_INLINE static s32 check_within_bounds_y_norm(s32 x, s32 z, struct Surface *surf) {
     if (surf->normal.y >= NORMAL_FLOOR_THRESHOLD) return check_within_floor_triangle_bounds(x, z, surf);
@@ -605,8 +767,15 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
     }
 
     // Check for surfaces that are a part of level geometry.
-    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next;
-    floor = find_floor_from_list(surfaceList, x, y, z, &height);
+#ifdef COMPACT_STATIC_FLOORS
+    if (gCompactFloors != NULL) {
+        floor = find_floor_from_compact_list(((cellZ * NUM_CELLS) + cellX), x, y, z, &height);
+    } else
+#endif
+    {
+        surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next;
+        floor = find_floor_from_list(surfaceList, x, y, z, &height);
+    }
 
     // Use the higher floor.
     if (includeDynamic && height <= dynamicHeight) {
@@ -44,6 +44,11 @@ struct WallCollisionData {
 
 s32 f32_find_wall_collision(f32 *xPtr, f32 *yPtr, f32 *zPtr, f32 offsetY, f32 radius);
 s32 find_wall_collisions(struct WallCollisionData *colData);
+#ifdef WALL_CLEARANCE_CACHE
+s32 find_wall_collisions_with_clearance(struct WallCollisionData *colData, struct WallClearance *clearance);
+#else
+#define find_wall_collisions_with_clearance(colData, clearance) find_wall_collisions(colData)
+#endif
 void resolve_and_return_wall_collisions(Vec3f pos, f32 offset, f32 radius, struct WallCollisionData *collisionData);
 f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil);
 
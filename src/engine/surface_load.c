@@ -14,6 +14,7 @@
 #include "game/object_list_processor.h"
 #include "surface_load.h"
 #include "game/puppyprint.h"
+#include "string.h"
 
 #include "config.h"
 
@@ -42,6 +43,16 @@ s32 sSurfacePoolSize = SURFACE_POOL_SIZE;
 
 u8 gSurfacePoolError = 0x0;
 
+#ifdef COMPACT_STATIC_FLOORS
+/**
+ * The static floors of every cell, see build_compact_static_floors.
+ * The floors of a cell are gCompactFloors[gCompactFloorCells[cell]] up to gCompactFloorCells[cell + 1],
+ * where cell is (cellZ * NUM_CELLS + cellX). NULL if the area's floors didn't fit.
+ */
+struct CompactFloor *gCompactFloors = NULL;
+u16 gCompactFloorCells[NUM_CELLS * NUM_CELLS + 1];
+#endif
+
 /**
  * Allocate the part of the surface node pool to contain a surface node.
  */
@@ -234,8 +245,9 @@ static void add_surface(struct Surface *surface, s32 dynamic) {
  * Initializes a Surface struct using the given vertex data
  * @param vertexData The raw data containing vertex positions
  * @param vertexIndices Helper which tells positions in vertexData to start reading vertices
+ * @param normal The surface's normal if it is already known, otherwise NULL to compute it from the vertices
  */
-static struct Surface *read_surface_data(TerrainData *vertexData, TerrainData **vertexIndices) {
+static struct Surface *read_surface_data(TerrainData *vertexData, TerrainData **vertexIndices, Vec3f normal) {
     Vec3t v[3];
     Vec3f n;
     Vec3t offset;
@@ -247,9 +259,13 @@ static struct Surface *read_surface_data(TerrainData *vertexData, TerrainData **
     vec3s_copy(v[1], (vertexData + offset[1]));
     vec3s_copy(v[2], (vertexData + offset[2]));
 
-    find_vector_perpendicular_to_plane(n, v[0], v[1], v[2]);
+    if (normal != NULL) {
+        vec3f_copy(n, normal);
+    } else {
+        find_vector_perpendicular_to_plane(n, v[0], v[1], v[2]);
 
-    vec3f_normalize(n);
+        vec3f_normalize(n);
+    }
 
     struct Surface *surface = alloc_surface();
 
@@ -338,7 +354,7 @@ static void load_static_surfaces(TerrainData **data, TerrainData *vertexData, s3
             room = *(*surfaceRooms)++;
         }
 
-        surface = read_surface_data(vertexData, data);
+        surface = read_surface_data(vertexData, data, NULL);
         if (surface != NULL) {
             surface->room = room;
             surface->type = surfaceType;
@@ -404,7 +420,130 @@ void alloc_surface_pools(void) {
 
     gCCMEnteredSlide = FALSE;
     reset_red_coins_collected();
+#ifdef COMPACT_STATIC_FLOORS
+    gCompactFloors = NULL;
+#endif
+}
+
+#ifdef COMPACT_STATIC_FLOORS
+#define ALIGN16(val) (((val) + 0xF) & ~0xF)
+
+/**
+ * Copy the static floor lists into gCompactFloors, in the same order.
+ * The copies are stored in the surface node pool after the static surface nodes,
+ * so they are kept until the next area's collision is loaded.
+ */
+static void build_compact_static_floors(void) {
+    SpatialPartitionCell *cells = &gStaticSurfacePartition[0][0];
+    struct SurfaceNode *node;
+    struct CompactFloor *compactFloor;
+    struct Surface *surf;
+    s32 numFloors = 0;
+    s32 cell;
+
+    gCompactFloors = NULL;
+
+    if (gSurfacesAllocated > (COMPACT_FLOOR_INDEX_MASK + 1)) {
+        return;
+    }
+
+    for (cell = 0; cell < sqr(NUM_CELLS); cell++) {
+        for (node = cells[cell][SPATIAL_PARTITION_FLOORS].next; node != NULL; node = node->next) {
+            numFloors++;
+        }
+    }
+
+    // Start on a data cache line, and round the size up to whole nodes.
+    uintptr_t start = ALIGN16((uintptr_t) &sSurfaceNodePool[gSurfaceNodesAllocated]);
+    uintptr_t end = (start + (numFloors * sizeof(struct CompactFloor)));
+    s32 numNodes = ((end - (uintptr_t) sSurfaceNodePool + sizeof(struct SurfaceNode) - 1) / sizeof(struct SurfaceNode));
+
+    if (numFloors > 0xFFFF || numNodes >= sSurfaceNodePoolSize) {
+        return;
+    }
+
+    gCompactFloors = (struct CompactFloor *) start;
+    gSurfaceNodesAllocated = numNodes;
+    compactFloor = gCompactFloors;
+
+    for (cell = 0; cell < sqr(NUM_CELLS); cell++) {
+        gCompactFloorCells[cell] = (compactFloor - gCompactFloors);
+
+        for (node = cells[cell][SPATIAL_PARTITION_FLOORS].next; node != NULL; node = node->next) {
+            surf = node->surface;
+
+            compactFloor->lowerY = surf->lowerY;
+            compactFloor->surface = (surf - sSurfacePool);
+            if (surf->type == SURFACE_INTANGIBLE || surf->type == SURFACE_CAMERA_BOUNDARY
+                || (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION)) {
+                compactFloor->surface |= COMPACT_FLOOR_FILTERED;
+            }
+            compactFloor->vertices[0][0] = surf->vertex1[0];
+            compactFloor->vertices[0][1] = surf->vertex1[2];
+            compactFloor->vertices[1][0] = surf->vertex2[0];
+            compactFloor->vertices[1][1] = surf->vertex2[2];
+            compactFloor->vertices[2][0] = surf->vertex3[0];
+            compactFloor->vertices[2][1] = surf->vertex3[2];
+            compactFloor++;
+        }
+    }
+
+    gCompactFloorCells[sqr(NUM_CELLS)] = numFloors;
+}
+#endif
+
+#ifdef LAZY_MODEL_LOADING
+/**
+ * Build the models of the special objects in an area's terrain data ahead of time.
+ */
+void build_area_terrain_object_models(TerrainData *data) {
+    s32 end = FALSE;
+    TerrainData terrainLoadType;
+    s32 numVertices;
+    s32 numRegions;
+    s32 numSurfaces;
+#ifndef ALL_SURFACES_HAVE_FORCE
+    TerrainData hasForce;
+#endif
+
+    while (!end) {
+        terrainLoadType = *data++;
+
+        switch (terrainLoadType) {
+            case TERRAIN_LOAD_VERTICES:
+                numVertices = *data++;
+                data += 3 * numVertices;
+                break;
+
+            case TERRAIN_LOAD_OBJECTS:
+                build_special_object_models(&data);
+                break;
+
+            case TERRAIN_LOAD_ENVIRONMENT:
+                numRegions = *data++;
+                data += 6 * numRegions;
+                break;
+
+            case TERRAIN_LOAD_CONTINUE:
+                continue;
+
+            case TERRAIN_LOAD_END:
+                end = TRUE;
+                break;
+
+            default:
+                numSurfaces = *data++;
+#ifdef ALL_SURFACES_HAVE_FORCE
+                data += 4 * numSurfaces;
+#else
+                hasForce = surface_has_force(terrainLoadType);
+                data += (3 + hasForce) * numSurfaces;
+#endif
+                break;
+        }
+    }
 }
+#endif
 
 #ifdef NO_SEGMENTED_MEMORY
 /**
@@ -463,6 +602,176 @@ u32 get_area_terrain_size(TerrainData *data) {
 #endif
 
 
+#ifdef OBJECT_COLLISION_CACHE
+// The number of objects that can have their surfaces cached at once.
+#define OBJECT_COLLISION_CACHE_SLOTS 16
+// The number of surfaces shared by all cached objects.
+#define OBJECT_COLLISION_CACHE_SURFACES 256
+
+/**
+ * A copy of an object's transformed surfaces, along with the transform and
+ * scale that they were built with.
+ */
+struct ObjectCollisionCache {
+    struct Object *obj;
+    TerrainData *collisionData;
+    struct Surface *surfaces;
+    s16 numSurfaces;
+    s16 capacity;
+    Mat4 transform;
+    Vec3f scale;
+};
+
+static struct ObjectCollisionCache sObjectCollisionCaches[OBJECT_COLLISION_CACHE_SLOTS];
+static struct Surface sObjectCollisionCacheSurfaces[OBJECT_COLLISION_CACHE_SURFACES];
+static s32 sObjectCollisionCacheSurfacesUsed = 0;
+
+/**
+ * Clear every cache. Called when a level's terrain is loaded.
+ */
+static void clear_object_collision_caches(void) {
+    bzero(sObjectCollisionCaches, sizeof(sObjectCollisionCaches));
+    sObjectCollisionCacheSurfacesUsed = 0;
+}
+
+/**
+ * Find the cache owned by the current object, or NULL if it doesn't have one yet.
+ */
+static struct ObjectCollisionCache *find_object_collision_cache(void) {
+    struct ObjectCollisionCache *cache = sObjectCollisionCaches;
+    s32 i;
+
+    for (i = 0; i < OBJECT_COLLISION_CACHE_SLOTS; i++, cache++) {
+        if (cache->obj == o) {
+            return cache;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Give the current object a cache with room for numSurfaces surfaces, reusing the
+ * cache of an unloaded object if possible. Returns NULL if there is no room left.
+ */
+static struct ObjectCollisionCache *alloc_object_collision_cache(s32 numSurfaces) {
+    struct ObjectCollisionCache *cache = sObjectCollisionCaches;
+    s32 i;
+
+    for (i = 0; i < OBJECT_COLLISION_CACHE_SLOTS; i++, cache++) {
+        if (cache->capacity == 0) {
+            if (sObjectCollisionCacheSurfacesUsed + numSurfaces > OBJECT_COLLISION_CACHE_SURFACES) {
+                return NULL;
+            }
+
+            cache->surfaces = &sObjectCollisionCacheSurfaces[sObjectCollisionCacheSurfacesUsed];
+            cache->capacity = numSurfaces;
+            sObjectCollisionCacheSurfacesUsed += numSurfaces;
+            break;
+        }
+
+        if ((cache->obj == NULL || cache->obj->activeFlags == ACTIVE_FLAG_DEACTIVATED)
+            && cache->capacity >= numSurfaces) {
+            break;
+        }
+    }
+
+    if (i == OBJECT_COLLISION_CACHE_SLOTS) {
+        return NULL;
+    }
+
+    cache->obj = o;
+    cache->numSurfaces = 0;
+
+    return cache;
+}
+
+/**
+ * If the current object's transform and scale haven't changed since its surfaces
+ * were cached, add the cached surfaces again and return TRUE.
+ */
+static s32 load_object_surfaces_from_cache(struct ObjectCollisionCache *cache) {
+    // Same as transform_object_vertices, so that the transform is up to date.
+    if (o->header.gfx.throwMatrix == NULL) {
+        o->header.gfx.throwMatrix = &o->transform;
+        obj_build_transform_from_pos_and_angle(o, O_POS_INDEX, O_FACE_ANGLE_INDEX);
+    }
+
+    if (cache == NULL
+        || cache->numSurfaces == 0
+        || cache->collisionData != o->collisionData
+        || memcmp(cache->scale, o->header.gfx.scale, sizeof(Vec3f)) != 0
+        || memcmp(cache->transform, o->transform, sizeof(Mat4)) != 0) {
+        return FALSE;
+    }
+
+    struct Surface *cachedSurface = cache->surfaces;
+    s32 i;
+
+    for (i = 0; i < cache->numSurfaces; i++, cachedSurface++) {
+        struct Surface *surface = alloc_surface();
+
+        *surface = *cachedSurface;
+        add_surface(surface, TRUE);
+    }
+
+    return TRUE;
+}
+
+/**
+ * Copy the surfaces that were just loaded for the current object into its cache.
+ */
+static void save_object_surfaces_to_cache(struct ObjectCollisionCache *cache, s32 firstSurface) {
+    s32 numSurfaces = (gSurfacesAllocated - firstSurface);
+
+    if (cache == NULL || cache->capacity < numSurfaces) {
+        if (cache != NULL) {
+            // The object's collision grew, so give up its cache.
+            cache->obj = NULL;
+        }
+
+        cache = alloc_object_collision_cache(numSurfaces);
+        if (cache == NULL) {
+            return;
+        }
+    }
+
+    bcopy(&sSurfacePool[firstSurface], cache->surfaces, (numSurfaces * sizeof(struct Surface)));
+    cache->numSurfaces = numSurfaces;
+    cache->collisionData = o->collisionData;
+    vec3f_copy(cache->scale, o->header.gfx.scale);
+    mtxf_copy(cache->transform, o->transform);
+}
+#endif
+
+#ifdef LOCAL_COLLISION_NORMALS
+// The number of collision models that can have their normals stored at once.
+#define LOCAL_COLLISION_NORMALS_MODELS 16
+// The number of normals shared by all of the stored models.
+#define LOCAL_COLLISION_NORMALS_SURFACES 512
+
+/**
+ * The normals of a collision model's surfaces before it is transformed by an object.
+ */
+struct LocalCollisionNormals {
+    TerrainData *collisionData;
+    Vec3f *normals;
+};
+
+static struct LocalCollisionNormals sLocalCollisionNormals[LOCAL_COLLISION_NORMALS_MODELS];
+static Vec3f sLocalCollisionNormalsPool[LOCAL_COLLISION_NORMALS_SURFACES];
+static s32 sNumLocalCollisionNormals = 0;
+static s32 sLocalCollisionNormalsUsed = 0;
+
+/**
+ * Forget every stored model. Called when a level's terrain is loaded.
+ */
+static void clear_local_collision_normals(void) {
+    sNumLocalCollisionNormals = 0;
+    sLocalCollisionNormalsUsed = 0;
+}
+#endif
+
 /**
  * Process the level file, loading in vertices, surfaces, some objects, and environmental
  * boxes (water, gas, JRB fog).
@@ -478,8 +787,17 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
     gEnvironmentRegions = NULL;
     gSurfaceNodesAllocated = 0;
     gSurfacesAllocated = 0;
+#ifdef COMPACT_STATIC_FLOORS
+    gCompactFloors = NULL;
+#endif
 
     clear_static_surfaces();
+#ifdef OBJECT_COLLISION_CACHE
+    clear_object_collision_caches();
+#endif
+#ifdef LOCAL_COLLISION_NORMALS
+    clear_local_collision_normals();
+#endif
 
     // A while loop iterating through each section of the level data. Sections of data
     // are prefixed by a terrain "type." This type is reused for surfaces as the surface
@@ -517,6 +835,10 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
         }
     }
 
+#ifdef COMPACT_STATIC_FLOORS
+    build_compact_static_floors();
+#endif
+
     gNumStaticSurfaceNodes = gSurfaceNodesAllocated;
     gNumStaticSurfaces = gSurfacesAllocated;
 #if PUPPYPRINT_DEBUG
@@ -571,9 +893,12 @@ void transform_object_vertices(TerrainData **data, TerrainData *vertexData) {
 
 /**
  * Load in the surfaces for the o. This includes setting the flags, exertion, and room.
+ * If localNormals isn't NULL, the surface normals are rotated from it instead of being
+ * computed from the transformed vertices, and it is advanced past the loaded surfaces.
  */
-void load_object_surfaces(TerrainData **data, TerrainData *vertexData) {
+void load_object_surfaces(TerrainData **data, TerrainData *vertexData, Vec3f **localNormals) {
     s32 i;
+    Vec3f n;
 
     s32 surfaceType = *(*data)++;
     s32 numSurfaces = *(*data)++;
@@ -589,7 +914,14 @@ void load_object_surfaces(TerrainData **data, TerrainData *vertexData) {
     RoomData room = (o->behavior == segmented_to_virtual(bhvDddWarp)) ? 5 : 0;
 
     for (i = 0; i < numSurfaces; i++) {
-        struct Surface *surface = read_surface_data(vertexData, data);
+        struct Surface *surface;
+
+        if (localNormals != NULL) {
+            linear_mtxf_mul_vec3f(o->transform, n, *(*localNormals)++);
+            surface = read_surface_data(vertexData, data, n);
+        } else {
+            surface = read_surface_data(vertexData, data, NULL);
+        }
 
         if (surface != NULL) {
             surface->object = o;
@@ -642,15 +974,141 @@ static void get_optimal_coll_dist(struct Object *obj) {
 #endif
 
 /**
- * Transform an object's vertices, reload them, and render the object.
+ * Transform the current object's vertices and load its surfaces.
+ * @param localNormals The normals of the untransformed surfaces, or NULL to compute them
  */
-void load_object_collision_model(void) {
+static void transform_and_load_object_surfaces(Vec3f *localNormals) {
     TerrainData vertexData[600];
+    TerrainData *collisionData = o->collisionData;
+
+    collisionData++;
+    transform_object_vertices(&collisionData, vertexData);
+
+    // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
+    while (*collisionData != TERRAIN_LOAD_CONTINUE) {
+        load_object_surfaces(&collisionData, vertexData, ((localNormals != NULL) ? &localNormals : NULL));
+    }
+}
+
+#ifdef LOCAL_COLLISION_NORMALS
+/**
+ * Get the normals of the current object's surfaces in its own space, computing them
+ * the first time the collision model is loaded. Returns NULL if the object is scaled
+ * unevenly, since the normals can't simply be rotated then, or if there is no room left.
+ */
+static Vec3f *get_local_collision_normals(void) {
+    struct LocalCollisionNormals *model = sLocalCollisionNormals;
+    TerrainData *collisionData = o->collisionData;
+    f32 *scale = o->header.gfx.scale;
+    s32 i;
+
+    if (scale[0] != scale[1] || scale[0] != scale[2] || scale[0] <= 0.0f) {
+        return NULL;
+    }
+
+    for (i = 0; i < sNumLocalCollisionNormals; i++, model++) {
+        if (model->collisionData == collisionData) {
+            return model->normals;
+        }
+    }
+
+    if (sNumLocalCollisionNormals >= LOCAL_COLLISION_NORMALS_MODELS) {
+        return NULL;
+    }
+
+    TerrainData *data = (collisionData + 1);
+    s32 numVertices = *data++;
+    TerrainData *vertices = data;
+    TerrainData *surfaces = (data + (3 * numVertices));
+    s32 numSurfaces = 0;
+#ifndef ALL_SURFACES_HAVE_FORCE
+    TerrainData hasForce;
+#endif
+
+    // Count the surfaces first to make sure they fit.
+    for (data = surfaces; *data != TERRAIN_LOAD_CONTINUE;) {
+#ifdef ALL_SURFACES_HAVE_FORCE
+        data++;
+        numSurfaces += *data;
+        data += (1 + (4 * *data));
+#else
+        hasForce = surface_has_force(*data++);
+        numSurfaces += *data;
+        data += (1 + ((3 + hasForce) * *data));
+#endif
+    }
+
+    if (sLocalCollisionNormalsUsed + numSurfaces > LOCAL_COLLISION_NORMALS_SURFACES) {
+        return NULL;
+    }
+
+    model->collisionData = collisionData;
+    model->normals = &sLocalCollisionNormalsPool[sLocalCollisionNormalsUsed];
+    sLocalCollisionNormalsUsed += numSurfaces;
+    sNumLocalCollisionNormals++;
+
+    Vec3f *normal = model->normals;
+    s32 surfacesLeft;
+
+    for (data = surfaces; *data != TERRAIN_LOAD_CONTINUE;) {
+#ifdef ALL_SURFACES_HAVE_FORCE
+        data++;
+#else
+        hasForce = surface_has_force(*data++);
+#endif
+        surfacesLeft = *data++;
+
+        while (surfacesLeft--) {
+            TerrainData *v1 = (vertices + (3 * data[0]));
+            TerrainData *v2 = (vertices + (3 * data[1]));
+            TerrainData *v3 = (vertices + (3 * data[2]));
+
+            find_vector_perpendicular_to_plane(*normal, v1, v2, v3);
+            vec3f_normalize(*normal);
+            normal++;
+
+#ifdef ALL_SURFACES_HAVE_FORCE
+            data += 4;
+#else
+            data += (3 + hasForce);
+#endif
+        }
+    }
+
+    return model->normals;
+}
+#endif
+
+#ifdef OBJECT_COLLISION_CACHE
+/**
+ * Load the current object's surfaces from its cache if it hasn't moved,
+ * otherwise transform them again and update the cache.
+ */
+static void load_object_surfaces_with_cache(void) {
+    struct ObjectCollisionCache *cache = find_object_collision_cache();
+    s32 firstSurface = gSurfacesAllocated;
+
+    if (!load_object_surfaces_from_cache(cache)) {
+        transform_and_load_object_surfaces(NULL);
+        save_object_surfaces_to_cache(cache, firstSurface);
+    }
+}
+#endif
+
+enum CollisionLoadModes {
+    COLLISION_LOAD_DEFAULT,
+    COLLISION_LOAD_CACHED,
+    COLLISION_LOAD_ROTATING,
+};
+
+/**
+ * Transform an object's vertices, reload them, and render the object.
+ */
+static void load_object_collision_model_impl(UNUSED s32 mode) {
 #if PUPPYPRINT_DEBUG
     OSTime first = osGetTime();
 #endif
 
-    TerrainData *collisionData = o->collisionData;
     f32 marioDist = o->oDistanceToMario;
 
     // On an object's first frame, the distance is set to 19000.0f.
@@ -677,12 +1135,25 @@ void load_object_collision_model(void) {
         && (marioDist < o->oCollisionDistance)
         && !(o->activeFlags & ACTIVE_FLAG_IN_DIFFERENT_ROOM)
     ) {
-        collisionData++;
-        transform_object_vertices(&collisionData, vertexData);
-
-        // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
-        while (*collisionData != TERRAIN_LOAD_CONTINUE) {
-            load_object_surfaces(&collisionData, vertexData);
+        switch (mode) {
+#ifdef OBJECT_COLLISION_CACHE
+            case COLLISION_LOAD_CACHED:
+                load_object_surfaces_with_cache();
+                break;
+#endif
+#ifdef LOCAL_COLLISION_NORMALS
+            case COLLISION_LOAD_ROTATING:
+                // Make sure the transform is up to date before the normals are rotated by it.
+                if (o->header.gfx.throwMatrix == NULL) {
+                    o->header.gfx.throwMatrix = &o->transform;
+                    obj_build_transform_from_pos_and_angle(o, O_POS_INDEX, O_FACE_ANGLE_INDEX);
+                }
+                transform_and_load_object_surfaces(get_local_collision_normals());
+                break;
+#endif
+            default:
+                transform_and_load_object_surfaces(NULL);
+                break;
         }
     }
     COND_BIT((marioDist < o->oDrawingDistance), o->header.gfx.node.flags, GRAPH_RENDER_ACTIVE);
@@ -690,3 +1161,28 @@ void load_object_collision_model(void) {
     collisionTime[perfIteration] += osGetTime() - first;
 #endif
 }
+
+void load_object_collision_model(void) {
+    load_object_collision_model_impl(COLLISION_LOAD_DEFAULT);
+}
+
+#ifdef OBJECT_COLLISION_CACHE
+/**
+ * Same as load_object_collision_model, but for objects that rarely move. The transformed
+ * surfaces are cached and reused for as long as the object's transform and scale stay the same.
+ */
+void load_object_collision_model_cached(void) {
+    load_object_collision_model_impl(COLLISION_LOAD_CACHED);
+}
+#endif
+
+#ifdef LOCAL_COLLISION_NORMALS
+/**
+ * Same as load_object_collision_model, but for objects that keep rotating, such as the
+ * TTC cogs and the WF rotating platforms. Only the vertices are transformed each frame,
+ * the normals are rotated from the ones computed once for the untransformed model.
+ */
+void load_object_collision_model_rotating(void) {
+    load_object_collision_model_impl(COLLISION_LOAD_ROTATING);
+}
+#endif
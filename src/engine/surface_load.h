@@ -28,19 +28,52 @@ enum SpatialPartitions {
 
 typedef struct SurfaceNode SpatialPartitionCell[NUM_SPATIAL_PARTITIONS];
 
+#ifdef COMPACT_STATIC_FLOORS
+// Set on floors that some queries skip, see find_floor_from_compact_list.
+#define COMPACT_FLOOR_FILTERED   0x8000
+#define COMPACT_FLOOR_INDEX_MASK 0x7FFF
+
+/**
+ * A copy of a static floor holding only what's needed to reject it,
+ * so that a cell's floors fit in a few data cache lines.
+ */
+struct CompactFloor {
+    /*0x00*/ s16 lowerY;
+    /*0x02*/ u16 surface; // Index into sSurfacePool, ORed with COMPACT_FLOOR_FILTERED.
+    /*0x04*/ TerrainData vertices[3][2]; // X and Z of each vertex.
+}; /*0x10*/
+#endif
+
 extern SpatialPartitionCell gStaticSurfacePartition[NUM_CELLS][NUM_CELLS];
 extern SpatialPartitionCell gDynamicSurfacePartition[NUM_CELLS][NUM_CELLS];
 extern struct SurfaceNode *sSurfaceNodePool;
 extern struct Surface *sSurfacePool;
 extern s32 sSurfaceNodePoolSize;
 extern s32 sSurfacePoolSize;
+#ifdef COMPACT_STATIC_FLOORS
+extern struct CompactFloor *gCompactFloors;
+extern u16 gCompactFloorCells[NUM_CELLS * NUM_CELLS + 1];
+#endif
 
 void alloc_surface_pools(void);
 #ifdef NO_SEGMENTED_MEMORY
 u32 get_area_terrain_size(TerrainData *data);
 #endif
 void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, MacroObject *macroObjects);
+#ifdef LAZY_MODEL_LOADING
+void build_area_terrain_object_models(TerrainData *data);
+#endif
 void clear_dynamic_surfaces(void);
 void load_object_collision_model(void);
+#ifdef OBJECT_COLLISION_CACHE
+void load_object_collision_model_cached(void);
+#else
+#define load_object_collision_model_cached load_object_collision_model
+#endif
+#ifdef LOCAL_COLLISION_NORMALS
+void load_object_collision_model_rotating(void);
+#else
+#define load_object_collision_model_rotating load_object_collision_model
+#endif
 
 #endif // SURFACE_LOAD_H
@@ -225,6 +225,10 @@ void clear_area_graph_nodes(void) {
             gAreaData[i].graphNode = NULL;
         }
     }
+
+#ifdef GEO_MEMOIZATION
+    geo_memo_clear();
+#endif
 }
 
 void load_area(s32 index) {
@@ -381,7 +385,21 @@ void render_game(void) {
 #endif
     if (gCurrentArea != NULL && !gWarpTransition.pauseRendering) {
         if (gCurrentArea->graphNode) {
+#ifdef FROZEN_PAUSE_FRAME
+            // Once the pause menu has been open for a frame, draw the scene from then instead of processing it again.
+            // Other menus and dialogs animate the scene behind them, so they still process it every frame.
+            if (gFrozenFrameCaptured) {
+                draw_frozen_frame();
+            } else {
+                geo_process_root(gCurrentArea->graphNode, gViewportOverride, gViewportClip, gFBSetColor);
+
+                if (gMenuMode == MENU_MODE_RENDER_PAUSE_SCREEN) {
+                    capture_frozen_frame();
+                }
+            }
+#else
             geo_process_root(gCurrentArea->graphNode, gViewportOverride, gViewportClip, gFBSetColor);
+#endif
         }
 
         gSPViewport(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(&gViewport));
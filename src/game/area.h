@@ -173,6 +173,14 @@ extern s16 gSaveOptSelectIndex;
 
 extern struct SpawnInfo *gMarioSpawnInfo;
 
+#ifdef LAZY_MODEL_LOADING
+struct GraphNode *get_loaded_graph_node(ModelID32 model);
+s32 model_uses_graph_node(ModelID32 model, struct GraphNode *node);
+#else
+#define get_loaded_graph_node(model) (gLoadedGraphNodes[model])
+#define model_uses_graph_node(model, node) ((node) == gLoadedGraphNodes[model])
+#endif
+
 extern struct Area *gAreas;
 extern struct Area *gCurrentArea;
 
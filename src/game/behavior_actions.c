@@ -2,14 +2,19 @@
 
 #include "types.h"
 #include "actors/common1.h"
+#include "actors/group0.h"
+#include "actors/group9.h"
 #include "actors/group12.h"
 #include "actors/group13.h"
+#include "actors/group14.h"
 #include "area.h"
 #include "audio/external.h"
 #include "behavior_actions.h"
 #include "behavior_data.h"
 #include "camera.h"
+#include "coin_manager.h"
 #include "debug.h"
+#include "effect_pool.h"
 #include "dialog_ids.h"
 #include "engine/behavior_script.h"
 #include "engine/graph_node.h"
@@ -128,6 +128,15 @@ void bhv_init_room(void);
 void bhv_small_water_wave_loop(void);
 void bhv_yellow_coin_init(void);
 void bhv_yellow_coin_loop(void);
+#ifdef EFFECT_POOL
+struct Effect;
+s32 effect_coin_sparkle_update(struct Effect *effect);
+s32 spawn_coin_sparkle_effects(struct Object *parent, Vec3f pos);
+s32 effect_white_puff_update(struct Effect *effect);
+#endif
+#ifdef COIN_MANAGER
+void bhv_coin_manager_loop(void);
+#endif
 void bhv_squarish_path_moving_loop(void);
 void bhv_heave_ho_loop(void);
 void bhv_heave_ho_throw_mario_loop(void);
@@ -557,12 +566,22 @@ Gfx *geo_bits_bowser_coloring(s32 callContext, struct GraphNode *node, UNUSED s3
 Gfx *geo_update_body_rot_from_parent(s32 callContext, UNUSED struct GraphNode *node, Mat4 mtx);
 Gfx *geo_switch_bowser_eyes(s32 callContext, struct GraphNode *node, UNUSED Mat4 *mtx);
 
+// Boo
+#ifdef TRANSPARENT_OBJECT_BATCHING
+Gfx *geo_boo_append_batch_instance(s32 callContext, UNUSED struct GraphNode *node, UNUSED void *context);
+#endif
+
 // Tuxie
 Gfx *geo_switch_tuxie_mother_eyes(s32 callContext, struct GraphNode *node, UNUSED Mat4 *mtx);
 
 // Cap switch
 Gfx *geo_update_held_mario_pos(s32 callContext, UNUSED struct GraphNode *node, Mat4 mtx);
 
+// Chain Chomp
+#ifdef CHAIN_CHOMP_RENDER_ONLY_CHAIN
+Gfx *geo_chain_chomp_draw_chain(s32 callContext, struct GraphNode *node, UNUSED void *context);
+#endif
+
 // Snufit
 Gfx *geo_snufit_move_mask(s32 callContext, struct GraphNode *node, UNUSED Mat4 *mtx);
 Gfx *geo_snufit_scale_body(s32 callContext, struct GraphNode *node, UNUSED Mat4 *mtx);
@@ -907,3 +907,33 @@ void bhv_boo_staircase(void) {
             break;
     }
 }
+
+#ifdef TRANSPARENT_OBJECT_BATCHING
+static const Gfx *const sBooBatchMaterials[] = {
+    boo_seg5_dl_batch_mouth_material,
+    boo_seg5_dl_batch_eyes_material,
+    boo_seg5_dl_batch_body_material,
+};
+
+static const Gfx *const sBooBatchGeometry[] = {
+    boo_seg5_dl_batch_mouth,
+    boo_seg5_dl_batch_eyes,
+    boo_seg5_dl_0500BFA0,
+};
+
+// Every boo on a layer is drawn mouth first, then eyes, then body, loading each texture only once.
+static const struct DisplayListBatch sBooDisplayListBatch = {
+    sBooBatchMaterials,
+    sBooBatchGeometry,
+    boo_seg5_dl_batch_end,
+    ARRAY_COUNT(sBooBatchMaterials),
+};
+
+Gfx *geo_boo_append_batch_instance(s32 callContext, UNUSED struct GraphNode *node, UNUSED void *context) {
+    if (callContext == GEO_CONTEXT_RENDER) {
+        geo_append_transparent_batch_instance(&sBooDisplayListBatch);
+    }
+
+    return NULL;
+}
+#endif
@@ -72,8 +72,16 @@ void bowser_flame_move(void) {
 }
 
 void bhv_flame_bowser_loop(void) {
+#ifdef BOWSER_FLAME_SKIP_LANDED_COLLISION
+    // Once a flame has landed it stops moving, so on static ground its floor and walls can't change.
+    if (o->oAction == 0 || o->oFloor == NULL || (o->oFloor->flags & SURFACE_FLAG_DYNAMIC)) {
+        cur_obj_update_floor_and_walls();
+        cur_obj_move_standard(78);
+    }
+#else
     cur_obj_update_floor_and_walls();
     cur_obj_move_standard(78);
+#endif
 
     if (o->oVelY < -4.0f) {
         o->oVelY = -4.0f;
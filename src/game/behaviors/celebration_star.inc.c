@@ -7,13 +7,13 @@ void bhv_celebration_star_init(void) {
     o->oMoveAngleYaw = gMarioObject->header.gfx.angle[1] + 0x8000;
     o->oCelebStarDiameterOfRotation = 100;
     if (gCurrLevelNum == LEVEL_BOWSER_1 || gCurrLevelNum == LEVEL_BOWSER_2) {
-        o->header.gfx.sharedChild = gLoadedGraphNodes[MODEL_BOWSER_KEY];
+        o->header.gfx.sharedChild = get_loaded_graph_node(MODEL_BOWSER_KEY);
         o->oFaceAnglePitch = 0;
         o->oFaceAngleRoll = 0xC000;
         cur_obj_scale(0.1f);
         o->oCelebStarIsBowserKey = 1;
     } else {
-        o->header.gfx.sharedChild = gLoadedGraphNodes[MODEL_STAR];
+        o->header.gfx.sharedChild = get_loaded_graph_node(MODEL_STAR);
         o->oFaceAnglePitch = 0;
         o->oFaceAngleRoll = 0;
         cur_obj_scale(0.4f);
@@ -70,11 +70,13 @@ static void chain_chomp_act_uninitialized(void) {
             // Spawn the pivot and set to parent
             o->parentObj = spawn_object(o, CHAIN_CHOMP_CHAIN_PART_BP_PIVOT, bhvChainChompChainPart);
             if (o->parentObj != NULL) {
+#ifndef CHAIN_CHOMP_RENDER_ONLY_CHAIN
                 // Spawn the non-pivot chain parts, starting from the chain
                 // chomp and moving toward the pivot
                 for (i = 1; i < CHAIN_CHOMP_NUM_SEGMENTS; i++) {
                     spawn_object_relative(i, 0, 0, 0, o, MODEL_METALLIC_BALL, bhvChainChompChainPart);
                 }
+#endif
 
                 o->oAction = CHAIN_CHOMP_ACT_MOVE;
                 cur_obj_unhide();
@@ -90,30 +92,60 @@ static void chain_chomp_act_uninitialized(void) {
 static void chain_chomp_update_chain_segments(void) {
     // Segment 0 connects the pivot to the chain chomp itself, and segment i>0
     // connects the pivot to chain part i (1 is closest to the chain chomp).
+    chain_segments_apply_tether(o->oChainChompSegments, CHAIN_CHOMP_NUM_SEGMENTS,
+                                (o->oVelY < 0.0f ? o->oVelY : -20.0f),
+                                o->oChainChompMaxDistBetweenChainParts,
+                                o->oChainChompMaxDistFromPivotPerChainPart);
+}
+
+#ifdef CHAIN_CHOMP_RENDER_ONLY_CHAIN
+/**
+ * Draw the chain parts between the pivot and the chain chomp as billboards,
+ * in place of spawning a bhvChainChompChainPart object for each of them.
+ */
+Gfx *geo_chain_chomp_draw_chain(s32 callContext, struct GraphNode *node, UNUSED void *context) {
+    struct GraphNodeGenerated *currentGraphNode = (struct GraphNodeGenerated *) node;
+    struct Object *obj = (struct Object *) gCurGraphNodeObject;
+
+    if (callContext != GEO_CONTEXT_RENDER || obj->oAction != CHAIN_CHOMP_ACT_MOVE) {
+        return NULL;
+    }
+
+    Gfx *dlStart = alloc_display_list((((CHAIN_CHOMP_NUM_SEGMENTS - 1) * 2) + 1) * sizeof(Gfx));
+    Gfx *dlHead  = dlStart;
+
+    if (dlStart == NULL) {
+        return NULL;
+    }
+
+    SET_GRAPH_NODE_LAYER(currentGraphNode->fnNode.node.flags, LAYER_ALPHA);
+
+    // Same scale and graph offset as bhvChainChompChainPart.
+    Vec3f scale = { 2.0f, 2.0f, 2.0f };
+    Vec3f pos;
+    Mat4 mtxf;
     s32 i;
+
     for (i = 1; i < CHAIN_CHOMP_NUM_SEGMENTS; i++) {
-        struct ChainSegment *prevSegment = &o->oChainChompSegments[i - 1];
-        struct ChainSegment *segment     = &o->oChainChompSegments[i];
+        vec3f_sum(pos, &obj->parentObj->oPosVec, obj->oChainChompSegments[i].pos);
+        pos[1] += 40.0f;
+        mtxf_billboard(mtxf, *gCurGraphNodeCamera->matrixPtr, pos, scale, gCurGraphNodeCamera->roll);
 
-        // Apply gravity
-        segment->pos[1] += o->oVelY < 0.0f ? o->oVelY : -20.0f;
-        if (segment->pos[1] < 0.0f) {
-            segment->pos[1] = 0.0f;
+        Mtx *partMtx = alloc_display_list(sizeof(Mtx));
+        if (partMtx == NULL) {
+            break;
         }
 
-        // Cap distance to previous chain part (so that the tail follows the chomp)
-        Vec3f offset;
-        vec3f_diff(offset, segment->pos, prevSegment->pos);
-        vec3_normalize_max(offset, o->oChainChompMaxDistBetweenChainParts);
+        mtxf_to_mtx(partMtx, mtxf);
+        gSPMatrix(dlHead++, VIRTUAL_TO_PHYSICAL(partMtx), (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+        gSPDisplayList(dlHead++, chain_ball_seg6_dl_060212E8);
+    }
 
-        // Cap distance to pivot (so that it stretches when the chomp moves far from the wooden post)
-        vec3f_add(offset, prevSegment->pos);
-        f32 maxTotalDist = o->oChainChompMaxDistFromPivotPerChainPart * (CHAIN_CHOMP_NUM_SEGMENTS - i);
-        vec3_normalize_max(offset, maxTotalDist);
+    gSPEndDisplayList(dlHead);
 
-        vec3f_copy(segment->pos, offset);
-    }
+    return dlStart;
 }
+#endif
 
 /**
  * Lunging increases the maximum distance from the pivot and changes the maximum
@@ -32,10 +32,71 @@ s16 sCoinArrowPositions[][2] = {
     { 100, 50 },
 };
 
+#ifdef EFFECT_POOL
+// The frames of sparkles_geo used by bhvCoinSparkles.
+static const Gfx *const sCoinSparkleFrames[] = {
+    sparkles_seg4_dl_0402A570,
+    sparkles_seg4_dl_0402A570,
+    sparkles_seg4_dl_0402A558,
+    sparkles_seg4_dl_0402A558,
+    sparkles_seg4_dl_0402A540,
+    sparkles_seg4_dl_0402A540,
+    sparkles_seg4_dl_0402A528,
+    sparkles_seg4_dl_0402A528,
+};
+
+/**
+ * Effect version of bhvCoinSparkles.
+ */
+s32 effect_coin_sparkle_update(struct Effect *effect) {
+    if (effect->timer >= 10) {
+        return TRUE;
+    }
+
+    if (effect->timer < 8) {
+        effect->animState = effect->timer;
+    } else {
+        effect->scale = 0.6f;
+    }
+
+    return FALSE;
+}
+
+/**
+ * Spawn the sparkles of a collected coin as effects, one per frame like bhvCoinSparklesSpawner.
+ * Returns FALSE if the effect pool is full.
+ */
+s32 spawn_coin_sparkle_effects(struct Object *parent, Vec3f pos) {
+    s32 i;
+
+    for (i = 0; i < 3; i++) {
+        struct Effect *sparkle = spawn_effect(parent, sCoinSparkleFrames, LAYER_OCCLUDE_SILHOUETTE_ALPHA,
+                                              effect_coin_sparkle_update);
+        if (sparkle == NULL) {
+            return (i != 0);
+        }
+
+        sparkle->pos[0] = pos[0] + random_float() * 30.0f - 15.0f;
+        sparkle->pos[1] = pos[1];
+        sparkle->pos[2] = pos[2] + random_float() * 30.0f - 15.0f;
+        sparkle->graphYOffset = 25.0f;
+        sparkle->timer = -i;
+    }
+
+    return TRUE;
+}
+#endif
+
 s32 bhv_coin_sparkles_init(void) {
     if (o->oInteractStatus & INT_STATUS_INTERACTED
         && !(o->oInteractStatus & INT_STATUS_TOUCHED_BOB_OMB)) {
+#ifdef EFFECT_POOL
+        if (!spawn_coin_sparkle_effects(o, &o->oPosVec)) {
+            spawn_object(o, MODEL_SPARKLES, bhvCoinSparklesSpawner);
+        }
+#else
         spawn_object(o, MODEL_SPARKLES, bhvCoinSparklesSpawner);
+#endif
         obj_mark_for_deletion(o);
         return TRUE;
     }
@@ -46,6 +107,10 @@ s32 bhv_coin_sparkles_init(void) {
 }
 
 void bhv_yellow_coin_init(void) {
+#ifdef COIN_MANAGER
+    // Only coins that stay in place forever can be handed to the coin manager.
+    s32 isStaticCoin = (cur_obj_has_behavior(bhvYellowCoin) || cur_obj_has_behavior(bhvOneCoin));
+#endif
     cur_obj_set_behavior(bhvYellowCoin);
     obj_set_hitbox(o, &sYellowCoinHitbox);
     cur_obj_update_floor_height();
@@ -66,7 +131,14 @@ void bhv_yellow_coin_init(void) {
 
     if (o->oFloorHeight < FLOOR_LOWER_LIMIT_MISC) {
         obj_mark_for_deletion(o);
+        return;
+    }
+
+#ifdef COIN_MANAGER
+    if (isStaticCoin && coin_manager_add_static_coin(o)) {
+        obj_mark_for_deletion(o);
     }
+#endif
 }
 
 void bhv_yellow_coin_loop(void) {
@@ -74,6 +146,12 @@ void bhv_yellow_coin_loop(void) {
     o->oAnimState++;
 }
 
+#ifdef COIN_MANAGER
+void bhv_coin_manager_loop(void) {
+    o->oAnimState++;
+}
+#endif
+
 void bhv_temp_coin_loop(void) {
     o->oAnimState++;
 
@@ -215,6 +293,21 @@ void spawn_coin_in_formation(s32 index, s32 shape) {
     }
 
     if (spawnCoin) {
+#ifdef COIN_MANAGER
+        Vec3f relativePos, coinPos;
+        Vec3s angle;
+        Mat4 transform;
+
+        // Same transform as spawn_object_relative.
+        vec3f_set(relativePos, pos[0], pos[1], pos[2]);
+        vec3i_to_vec3s(angle, &o->oFaceAngleVec);
+        mtxf_rotate_zxy_and_translate(transform, &o->oPosVec, angle);
+        linear_mtxf_mul_vec3f_and_translate(transform, coinPos, relativePos);
+
+        if (coin_manager_add_formation_coin(o, index, coinPos, snapToGround)) {
+            return;
+        }
+#endif
         struct Object *newCoin =
             spawn_object_relative(index, pos[0], pos[1], pos[2], o,
                                   MODEL_YELLOW_COIN, bhvCoinFormationSpawnedCoin);
@@ -246,6 +339,9 @@ void bhv_coin_formation_loop(void) {
             }
             break;
         case COIN_FORMATION_ACT_DEACTIVATE:
+#ifdef COIN_MANAGER
+            coin_manager_remove_formation(o);
+#endif
             o->oAction = COIN_FORMATION_ACT_INACTIVE;
             break;
     }
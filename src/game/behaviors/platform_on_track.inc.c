@@ -30,7 +30,89 @@ static Trajectory const *sPlatformOnTrackPaths[] = {
     rr_seg7_trajectory_0702EEE0,
 };
 
+#ifdef PATH_CACHE
+/**
+ * Same as platform_on_track_update_pos_or_spawn_ball, but using the distance
+ * the platform has moved along its path instead of walking the waypoints.
+ */
+static void platform_on_track_update_pos_or_spawn_ball_on_path(struct PathCache *path, s32 ballIndex) {
+    s32 returnToStart = (GET_BPARAM1(o->oBehParams) & PLATFORM_ON_TRACK_BP_RETURN_TO_START);
+    s32 prevSegment = (o->oPlatformOnTrackPrevWaypoint - path->waypoints);
+    f32 dist = o->oPlatformOnTrackDistAlongPath;
+    s32 segment;
+    Vec3f pos;
+
+    if (ballIndex != 0) {
+        dist += (300.0f * ballIndex);
+        if (dist > path->length && !returnToStart) {
+            return;
+        }
+        while (dist >= path->loopLength) {
+            dist -= path->loopLength;
+        }
+
+        segment = path_cache_find_segment(path, dist, prevSegment);
+        path_cache_get_pos(path, dist, segment, pos);
+
+        struct Object *trackBall = spawn_object_relative((o->oPlatformOnTrackBaseBallIndex + ballIndex), 0, 0, 0, o,
+                                          MODEL_TRAJECTORY_MARKER_BALL, bhvTrackBall);
+        if (trackBall != NULL) {
+            vec3f_copy(&trackBall->oPosVec, pos);
+        }
+        return;
+    }
+
+    obj_perform_position_op(POS_OP_SAVE_POSITION);
+    o->oPlatformOnTrackPrevWaypointFlags = WAYPOINT_FLAGS_NONE;
+
+    dist += o->oForwardVel;
+
+    // Passing the last waypoint either stops the platform where it is, or continues back to the start waypoint
+    if (o->oPlatformOnTrackDistAlongPath <= path->length && dist > path->length) {
+        o->oPlatformOnTrackPrevWaypointFlags = WAYPOINT_FLAGS_END;
+        if (!returnToStart) {
+            return;
+        }
+    }
+    while (dist >= path->loopLength) {
+        dist -= path->loopLength;
+    }
+
+    segment = path_cache_find_segment(path, dist, prevSegment);
+    if (segment != prevSegment) {
+        if (o->oPlatformOnTrackPrevWaypointFlags == WAYPOINT_FLAGS_NONE) {
+            o->oPlatformOnTrackPrevWaypointFlags = o->oPlatformOnTrackPrevWaypoint->flags;
+        }
+        o->oPlatformOnTrackPrevWaypoint = (struct Waypoint *) &path->waypoints[segment];
+    }
+
+    o->oPlatformOnTrackDistAlongPath = dist;
+    path_cache_get_pos(path, dist, segment, &o->oPosVec);
+
+    obj_perform_position_op(POS_OP_COMPUTE_VELOCITY);
+
+    if (segment == prevSegment) {
+        // Moving along a single segment, so the velocity points the same way as the segment.
+        o->oPlatformOnTrackPitch = path->segments[segment].pitch;
+        o->oPlatformOnTrackYaw = path->segments[segment].yaw;
+    } else {
+        // Passing a waypoint, so the velocity points somewhere between both segments.
+        o->oPlatformOnTrackPitch = atan2s(sqrtf(sqr(o->oVelX) + sqr(o->oVelZ)), -o->oVelY);
+        o->oPlatformOnTrackYaw = atan2s(o->oVelZ, o->oVelX);
+    }
+}
+#endif
+
 static void platform_on_track_update_pos_or_spawn_ball(s32 ballIndex, Vec3f pos) {
+#ifdef PATH_CACHE
+    struct PathCache *path = path_cache_get(o->oPlatformOnTrackStartWaypoint);
+    if (path != NULL) {
+        if ((ballIndex == 0) || (GET_BPARAM2(o->oBehParams) & PLATFORM_ON_TRACK_BP_SPAWN_BALLS)) {
+            platform_on_track_update_pos_or_spawn_ball_on_path(path, ballIndex);
+        }
+        return;
+    }
+#endif
     if ((ballIndex == 0) || (GET_BPARAM2(o->oBehParams) & PLATFORM_ON_TRACK_BP_SPAWN_BALLS)) {
         struct Waypoint *initialPrevWaypoint = o->oPlatformOnTrackPrevWaypoint;
         struct Waypoint *nextWaypoint = initialPrevWaypoint;
@@ -167,6 +249,9 @@ static void platform_on_track_act_init(void) {
     o->oPlatformOnTrackPrevWaypoint = o->oPlatformOnTrackStartWaypoint;
     o->oPlatformOnTrackPrevWaypointFlags = WAYPOINT_FLAGS_NONE;
     o->oPlatformOnTrackBaseBallIndex = 0;
+#ifdef PATH_CACHE
+    o->oPlatformOnTrackDistAlongPath = 0.0f;
+#endif
 
     vec3s_to_vec3f(&o->oHomeVec, o->oPlatformOnTrackStartWaypoint->pos);
     vec3f_copy(&o->oPosVec, &o->oHomeVec);
@@ -21,9 +21,9 @@ void bhv_collect_star_init(void) {
     u8 currentLevelStarFlags = save_file_get_star_flags((gCurrSaveFileNum - 1), COURSE_NUM_TO_INDEX(gCurrCourseNum));
     if (currentLevelStarFlags & (1 << starId)) {
 #endif
-        o->header.gfx.sharedChild = gLoadedGraphNodes[MODEL_TRANSPARENT_STAR];
+        o->header.gfx.sharedChild = get_loaded_graph_node(MODEL_TRANSPARENT_STAR);
     } else {
-        o->header.gfx.sharedChild = gLoadedGraphNodes[MODEL_STAR];
+        o->header.gfx.sharedChild = get_loaded_graph_node(MODEL_STAR);
     }
 
     obj_set_hitbox(o, &sCollectStarHitbox);
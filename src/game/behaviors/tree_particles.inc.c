@@ -49,8 +49,8 @@ void bhv_snow_leaf_particle_spawn_init(void) {
     struct Object *nearestTree = cur_obj_nearest_object_with_behavior(bhvTree);
     if (nearestTree == NULL) return;
     isSnow =
-        nearestTree->header.gfx.sharedChild == gLoadedGraphNodes[MODEL_CCM_SNOW_TREE]
-        || nearestTree->header.gfx.sharedChild == gLoadedGraphNodes[MODEL_SL_SNOW_TREE];
+        model_uses_graph_node(MODEL_CCM_SNOW_TREE, nearestTree->header.gfx.sharedChild)
+        || model_uses_graph_node(MODEL_SL_SNOW_TREE, nearestTree->header.gfx.sharedChild);
 
     if (isSnow) {
         if (random_float() < 0.5f) {
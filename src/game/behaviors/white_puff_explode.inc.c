@@ -43,3 +43,25 @@ void bhv_white_puff_exploding_loop(void) {
         cur_obj_scale(scale);
     }
 }
+
+#ifdef EFFECT_POOL
+/**
+ * Effect version of bhvWhitePuffExplosion, for particles that don't fade out.
+ */
+s32 effect_white_puff_update(struct Effect *effect) {
+    if (effect->timer > 20) {
+        return TRUE;
+    }
+
+    effect->vel[1] += effect->gravity;
+    vec3f_add(effect->pos, effect->vel);
+    apply_drag_to_value(&effect->vel[0], effect->dragStrength);
+    apply_drag_to_value(&effect->vel[2], effect->dragStrength);
+
+    if (effect->vel[1] > 100.0f) {
+        effect->vel[1] = 100.0f;
+    }
+
+    return FALSE;
+}
+#endif
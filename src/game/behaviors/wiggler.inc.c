@@ -154,40 +154,8 @@ void wiggler_init_segments(void) {
  * body.
  */
  void wiggler_update_segments(void) {
-    struct ChainSegment *prevBodyPart;
-    struct ChainSegment *bodyPart;
-    Vec3f d;
-    s16 dpitch, dyaw;
-    f32 dxz;
-    s32 i;
-    f32 segmentLength = (35.0f * o->header.gfx.scale[0]);
-
-    for (i = 1; i < WIGGLER_NUM_SEGMENTS; i++) {
-        prevBodyPart = &o->oWigglerSegments[i - 1];
-        bodyPart = &o->oWigglerSegments[i];
-
-        vec3_diff(d, bodyPart->pos, prevBodyPart->pos);
-
-        // As the head turns, propagate this rotation backward if the difference
-        // is more than 45 degrees
-        dyaw = atan2s(-d[2], -d[0]) - prevBodyPart->angle[1];
-        clamp_s16(&dyaw, -0x2000, 0x2000);
-        bodyPart->angle[1] = prevBodyPart->angle[1] + dyaw;
-
-        // As the head tilts, propagate the tilt backward
-        dxz = sqrtf(sqr(d[0]) + sqr(d[2]));
-        dpitch = atan2s(dxz, d[1]) - prevBodyPart->angle[0];
-        clamp_s16(&dpitch, -0x2000, 0x2000);
-        bodyPart->angle[0] = prevBodyPart->angle[0] + dpitch;
-
-        // Set the body part's position relative to the previous body part's
-        // position, using the current body part's angles. This means that the
-        // head can rotate up to 45 degrees without the body moving
-        bodyPart->pos[1] = segmentLength * sins(bodyPart->angle[0]) + prevBodyPart->pos[1];
-        dxz = segmentLength * coss(bodyPart->angle[0]);
-        bodyPart->pos[0] = prevBodyPart->pos[0] - dxz * sins(bodyPart->angle[1]);
-        bodyPart->pos[2] = prevBodyPart->pos[2] - dxz * coss(bodyPart->angle[1]);
-    }
+    // The head can rotate up to 45 degrees without the body moving.
+    chain_segments_apply_follow(o->oWigglerSegments, WIGGLER_NUM_SEGMENTS, (35.0f * o->header.gfx.scale[0]), 0x2000);
 }
 
 /**
@@ -0,0 +1,404 @@
+#include <ultra64.h>
+
+#include "sm64.h"
+#include "actors/common1.h"
+#include "area.h"
+#include "behavior_actions.h"
+#include "behavior_data.h"
+#include "coin_manager.h"
+#include "engine/graph_node.h"
+#include "engine/math_util.h"
+#include "engine/surface_collision.h"
+#include "game_init.h"
+#include "interaction.h"
+#include "level_update.h"
+#include "memory.h"
+#include "object_helpers.h"
+#include "object_list_processor.h"
+#include "rendering_graph_node.h"
+
+/**
+ * The coin manager owns every static yellow coin and every coin spawned by a
+ * coin formation. Instead of each coin being its own object with a behavior
+ * script and graph node, they are stored in a compact array.
+ * Pickups are tested against Mario's hitbox in a single pass while Mario
+ * processes his interactions, and every coin is drawn by one generated display
+ * list attached to a single manager object, so the coin texture only has to be
+ * loaded once per frame.
+ * Coins that need to move (such as those dropped by enemies) remain objects.
+ */
+
+#ifdef COIN_MANAGER
+
+// Coins further than this from Mario aren't drawn. Matches the default oDrawingDistance.
+#define COIN_MANAGER_DRAW_DISTANCE 4000.0f
+// Coins are never larger than this, used to skip coins behind the camera.
+#define COIN_MANAGER_CULLING_RADIUS 64.0f
+
+#define COIN_HITBOX_RADIUS 100.0f
+#define COIN_HITBOX_HEIGHT  64.0f
+
+static struct ManagedCoin sManagedCoins[COIN_MANAGER_CAPACITY];
+s32 gNumManagedCoins = 0;
+// One past the highest slot in use, so loops don't need to walk the whole array.
+static s32 sManagedCoinsEnd = 0;
+static struct Object *sCoinManagerObj = NULL;
+
+static struct GraphNodeCullingRadius sCoinManagerCullingNode;
+static struct GraphNodeGenerated     sCoinManagerDrawNode;
+
+#ifdef IA8_30FPS_COINS
+static const Gfx *sCoinManagerFrames[] = {
+    coin_seg3_dl_yellow_0,
+    coin_seg3_dl_yellow_22_5,
+    coin_seg3_dl_yellow_45,
+    coin_seg3_dl_yellow_67_5,
+    coin_seg3_dl_yellow_90,
+    coin_seg3_dl_yellow_67_5_r,
+    coin_seg3_dl_yellow_45_r,
+    coin_seg3_dl_yellow_22_5_r,
+};
+// The mirrored frames use a different set of vertices.
+static const Gfx *sCoinManagerBatchFrames[] = {
+    coin_seg3_dl_yellow_batch,
+    coin_seg3_dl_yellow_batch,
+    coin_seg3_dl_yellow_batch,
+    coin_seg3_dl_yellow_batch,
+    coin_seg3_dl_yellow_batch,
+    coin_seg3_dl_yellow_batch_r,
+    coin_seg3_dl_yellow_batch_r,
+    coin_seg3_dl_yellow_batch_r,
+};
+#else
+static const Gfx *sCoinManagerFrames[] = {
+    coin_seg3_dl_yellow_front,
+    coin_seg3_dl_yellow_front,
+    coin_seg3_dl_yellow_tilt_right,
+    coin_seg3_dl_yellow_tilt_right,
+    coin_seg3_dl_yellow_side,
+    coin_seg3_dl_yellow_side,
+    coin_seg3_dl_yellow_tilt_left,
+    coin_seg3_dl_yellow_tilt_left,
+};
+#endif
+
+/**
+ * Reset the manager. Called whenever the object pool is cleared.
+ */
+void coin_manager_clear(void) {
+    bzero(sManagedCoins, sizeof(sManagedCoins));
+    gNumManagedCoins = 0;
+    sManagedCoinsEnd = 0;
+    sCoinManagerObj  = NULL;
+}
+
+/**
+ * Remove every coin that belongs to the given area. The manager object
+ * itself is unloaded alongside the other objects in that area.
+ */
+void coin_manager_unload_area(s32 areaIndex) {
+    struct ManagedCoin *coin = sManagedCoins;
+    s32 i;
+
+    for (i = 0; i < sManagedCoinsEnd; i++, coin++) {
+        if ((coin->flags & COIN_MANAGER_FLAG_ACTIVE) && coin->areaIndex == areaIndex) {
+            coin->flags = COIN_MANAGER_FLAG_NONE;
+            gNumManagedCoins--;
+        }
+    }
+
+    if (sCoinManagerObj != NULL && sCoinManagerObj->header.gfx.areaIndex == areaIndex) {
+        sCoinManagerObj = NULL;
+    }
+}
+
+/**
+ * Spawn the object that draws the managed coins, if it doesn't exist yet.
+ * Its model is built here rather than loaded from a geo layout, since it
+ * never changes.
+ */
+static s32 coin_manager_spawn(struct Object *parent) {
+    if (sCoinManagerObj != NULL) {
+        return TRUE;
+    }
+
+    if (gFreeObjectList.next == NULL) {
+        return FALSE;
+    }
+
+    init_graph_node_culling_radius(NULL, &sCoinManagerCullingNode, 0x7FFF);
+    init_graph_node_generated(NULL, &sCoinManagerDrawNode, geo_coin_manager_draw, 0);
+    SET_GRAPH_NODE_LAYER(sCoinManagerDrawNode.fnNode.node.flags, LAYER_OCCLUDE_SILHOUETTE_ALPHA);
+    geo_add_child(&sCoinManagerCullingNode.node, &sCoinManagerDrawNode.fnNode.node);
+
+    sCoinManagerObj = spawn_object_abs_with_rot(parent, 0, MODEL_NONE, bhvCoinManager, 0, 0, 0, 0, 0, 0);
+    sCoinManagerObj->parentObj = sCoinManagerObj;
+    sCoinManagerObj->header.gfx.sharedChild = &sCoinManagerCullingNode.node;
+
+    return TRUE;
+}
+
+/**
+ * Find a free slot in the coin array, or return NULL if the manager is full.
+ */
+static struct ManagedCoin *coin_manager_alloc(struct Object *parent) {
+    struct ManagedCoin *coin = sManagedCoins;
+    s32 i;
+
+    if (gNumManagedCoins >= COIN_MANAGER_CAPACITY || !coin_manager_spawn(parent)) {
+        return NULL;
+    }
+
+    for (i = 0; i < COIN_MANAGER_CAPACITY; i++, coin++) {
+        if (!(coin->flags & COIN_MANAGER_FLAG_ACTIVE)) {
+            bzero(coin, sizeof(struct ManagedCoin));
+            coin->flags     = COIN_MANAGER_FLAG_ACTIVE;
+            coin->areaIndex = parent->header.gfx.areaIndex;
+
+            if (i >= sManagedCoinsEnd) {
+                sManagedCoinsEnd = (i + 1);
+            }
+            gNumManagedCoins++;
+
+            return coin;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Take ownership of a yellow coin that was placed in the level.
+ * Returns TRUE if the coin object is no longer needed and can be deleted.
+ */
+s32 coin_manager_add_static_coin(struct Object *obj) {
+    // Only coins that were placed in the level are static. Anything spawned
+    // by another object may be moved around by its spawner.
+    if (obj->respawnInfoType == RESPAWN_INFO_TYPE_NULL || obj->oDamageOrCoinValue != 1
+        || !(obj_has_model(obj, MODEL_YELLOW_COIN) || obj_has_model(obj, MODEL_YELLOW_COIN_NO_SHADOW))) {
+        return FALSE;
+    }
+
+    struct ManagedCoin *coin = coin_manager_alloc(obj);
+
+    if (coin == NULL) {
+        return FALSE;
+    }
+
+    vec3f_copy(coin->pos, &obj->oPosVec);
+    coin->respawnInfo     = obj->respawnInfo;
+    coin->respawnInfoType = obj->respawnInfoType;
+    coin->room            = obj->oRoom;
+
+    // The coin's respawn info is now tracked by the manager, so make sure
+    // unloading the object doesn't mark it as collected.
+    obj->respawnInfoType = RESPAWN_INFO_TYPE_NULL;
+
+    return TRUE;
+}
+
+/**
+ * Take ownership of a coin in a coin formation.
+ * Returns FALSE if the manager is full and the coin should be spawned as an object instead.
+ */
+s32 coin_manager_add_formation_coin(struct Object *formation, s32 index, Vec3f pos, s32 snapToGround) {
+    struct Surface *floor;
+    f32 floorHeight;
+
+    if (snapToGround) {
+        floorHeight = find_floor(pos[0], (pos[1] + 300.0f), pos[2], &floor);
+
+        // Same as bhv_coin_formation_spawned_coin_loop, the coin is never spawned.
+        if ((pos[1] + 300.0f) + FIND_FLOOR_BUFFER < floorHeight || floorHeight < FLOOR_LOWER_LIMIT_MISC) {
+            return TRUE;
+        }
+    }
+
+    struct ManagedCoin *coin = coin_manager_alloc(formation);
+
+    if (coin == NULL) {
+        return FALSE;
+    }
+
+    vec3f_copy(coin->pos, pos);
+    if (snapToGround) {
+        coin->pos[1] = floorHeight;
+    }
+
+    coin->flags |= COIN_MANAGER_FLAG_FORMATION;
+    coin->parent = formation;
+    coin->formationIndex = index;
+    coin->room = get_room_at_pos(coin->pos[0], coin->pos[1], coin->pos[2]);
+
+    return TRUE;
+}
+
+/**
+ * Remove all coins spawned by a coin formation once it deactivates.
+ */
+void coin_manager_remove_formation(struct Object *formation) {
+    struct ManagedCoin *coin = sManagedCoins;
+    s32 i;
+
+    for (i = 0; i < sManagedCoinsEnd; i++, coin++) {
+        if ((coin->flags & COIN_MANAGER_FLAG_ACTIVE) && coin->parent == formation) {
+            coin->flags = COIN_MANAGER_FLAG_NONE;
+            gNumManagedCoins--;
+        }
+    }
+}
+
+/**
+ * Whether a coin is in a room that is currently visible, see cur_obj_enable_rendering_if_mario_in_room.
+ * Only used to skip drawing coins, coins in other rooms can still be collected.
+ */
+static s32 coin_manager_coin_in_mario_room(struct ManagedCoin *coin) {
+    if (coin->room == -1 || gMarioCurrentRoom == 0) {
+        return TRUE;
+    }
+
+    return (gMarioCurrentRoom == coin->room
+            || gDoorAdjacentRooms[gMarioCurrentRoom][0] == coin->room
+            || gDoorAdjacentRooms[gMarioCurrentRoom][1] == coin->room);
+}
+
+/**
+ * Test every managed coin against Mario's hitbox, collecting any that overlap.
+ * Called during Mario's interaction processing, so 'o' is Mario.
+ */
+void coin_manager_collect(struct MarioState *m) {
+    struct Object *marioObj = m->marioObj;
+    struct ManagedCoin *coin = sManagedCoins;
+    s32 areaIndex = gCurrAreaIndex;
+    s32 i;
+
+    if (gNumManagedCoins == 0 || marioObj->oIntangibleTimer != 0) {
+        return;
+    }
+
+    f32 radius = sqr(marioObj->hitboxRadius + COIN_HITBOX_RADIUS);
+    f32 bottom = marioObj->oPosY - marioObj->hitboxDownOffset;
+    f32 top    = bottom + marioObj->hitboxHeight;
+
+    for (i = 0; i < sManagedCoinsEnd; i++, coin++) {
+        if (!(coin->flags & COIN_MANAGER_FLAG_ACTIVE) || coin->areaIndex != areaIndex) {
+            continue;
+        }
+
+        if (coin->pos[1] > top || coin->pos[1] + COIN_HITBOX_HEIGHT < bottom) {
+            continue;
+        }
+
+        f32 dx = coin->pos[0] - marioObj->oPosX;
+        f32 dz = coin->pos[2] - marioObj->oPosZ;
+
+        if (sqr(dx) + sqr(dz) >= radius) {
+            continue;
+        }
+
+        mario_add_coins(m, 1);
+
+        if (coin->flags & COIN_MANAGER_FLAG_FORMATION) {
+            coin->parent->oCoinRespawnBits |= (1 << coin->formationIndex);
+        } else {
+            set_respawn_info_bits(coin->respawnInfo, coin->respawnInfoType, RESPAWN_INFO_DONT_RESPAWN);
+        }
+
+#ifdef EFFECT_POOL
+        if (!spawn_coin_sparkle_effects(marioObj, coin->pos)) {
+            spawn_object_abs_with_rot(marioObj, 0, MODEL_SPARKLES, bhvCoinSparklesSpawner,
+                                      coin->pos[0], coin->pos[1], coin->pos[2], 0, 0, 0);
+        }
+#else
+        spawn_object_abs_with_rot(marioObj, 0, MODEL_SPARKLES, bhvCoinSparklesSpawner,
+                                  coin->pos[0], coin->pos[1], coin->pos[2], 0, 0, 0);
+#endif
+
+        coin->flags = COIN_MANAGER_FLAG_NONE;
+        gNumManagedCoins--;
+    }
+
+    // Shrink the active range if the last coins were collected.
+    while (sManagedCoinsEnd > 0 && !(sManagedCoins[sManagedCoinsEnd - 1].flags & COIN_MANAGER_FLAG_ACTIVE)) {
+        sManagedCoinsEnd--;
+    }
+}
+
+/**
+ * Draw every visible managed coin with a single display list.
+ * The first coin draws with the regular coin display list for the current
+ * frame, which loads the texture, and every following coin reuses it.
+ */
+Gfx *geo_coin_manager_draw(s32 callContext, UNUSED struct GraphNode *node, void *context) {
+    if (callContext != GEO_CONTEXT_RENDER || gNumManagedCoins == 0 || sCoinManagerObj == NULL) {
+        return NULL;
+    }
+
+    Gfx *dlStart = alloc_display_list(((gNumManagedCoins * 2) + 3) * sizeof(Gfx));
+    Gfx *dlHead  = dlStart;
+
+    if (dlStart == NULL) {
+        return NULL;
+    }
+
+    struct ManagedCoin *coin = sManagedCoins;
+    Vec3f scale = { 1.0f, 1.0f, 1.0f };
+    Vec3f marioPos;
+    s32 areaIndex = sCoinManagerObj->header.gfx.areaIndex;
+    s32 numDrawn = 0;
+    s32 frame = (sCoinManagerObj->oAnimState % ARRAY_COUNT(sCoinManagerFrames));
+    Mat4 mtxf;
+    s32 i;
+
+    vec3f_copy(marioPos, gMarioState->pos);
+
+    for (i = 0; i < sManagedCoinsEnd; i++, coin++) {
+        if (!(coin->flags & COIN_MANAGER_FLAG_ACTIVE) || coin->areaIndex != areaIndex) {
+            continue;
+        }
+
+        Vec3f d;
+        vec3_diff(d, coin->pos, marioPos);
+        if (vec3_sumsq(d) > sqr(COIN_MANAGER_DRAW_DISTANCE) || !coin_manager_coin_in_mario_room(coin)) {
+            continue;
+        }
+
+        mtxf_billboard(mtxf, context, coin->pos, scale, gCurGraphNodeCamera->roll);
+
+        // Skip coins that are behind the camera, see obj_is_in_view.
+        if (mtxf[3][2] > -100.0f + COIN_MANAGER_CULLING_RADIUS) {
+            continue;
+        }
+
+        Mtx *coinMtx = alloc_display_list(sizeof(Mtx));
+        if (coinMtx == NULL) {
+            break;
+        }
+
+        mtxf_to_mtx(coinMtx, mtxf);
+        gSPMatrix(dlHead++, VIRTUAL_TO_PHYSICAL(coinMtx), (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+
+        if (numDrawn == 0) {
+            gSPDisplayList(dlHead++, sCoinManagerFrames[frame]);
+            gSPDisplayList(dlHead++, coin_seg3_dl_batch_begin);
+        } else {
+#ifdef IA8_30FPS_COINS
+            gSPDisplayList(dlHead++, sCoinManagerBatchFrames[frame]);
+#else
+            gSPDisplayList(dlHead++, coin_seg3_dl_yellow_batch);
+#endif
+        }
+        numDrawn++;
+    }
+
+    if (numDrawn == 0) {
+        return NULL;
+    }
+
+    gSPDisplayList(dlHead++, coin_seg3_dl_batch_end);
+    gSPEndDisplayList(dlHead);
+
+    return dlStart;
+}
+
+#endif // COIN_MANAGER
@@ -0,0 +1,44 @@
+#ifndef COIN_MANAGER_H
+#define COIN_MANAGER_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+#ifdef COIN_MANAGER
+
+// The maximum number of coins the manager can own at once.
+// Any coins past this will fall back to being regular objects.
+#define COIN_MANAGER_CAPACITY 256
+
+enum CoinManagerFlags {
+    COIN_MANAGER_FLAG_NONE      = (0 << 0),
+    COIN_MANAGER_FLAG_ACTIVE    = (1 << 0),
+    COIN_MANAGER_FLAG_FORMATION = (1 << 1),
+};
+
+struct ManagedCoin {
+    /*0x00*/ Vec3f pos;
+    /*0x0C*/ struct Object *parent; // The coin formation that owns this coin, if any.
+    /*0x10*/ void *respawnInfo;
+    /*0x14*/ u8 flags;
+    /*0x15*/ u8 respawnInfoType;
+    /*0x16*/ s8 areaIndex;
+    /*0x17*/ s8 room;
+    /*0x18*/ u8 formationIndex;
+    /*0x19*/ u8 pad[3];
+}; /*0x1C*/
+
+extern s32 gNumManagedCoins;
+
+void coin_manager_clear(void);
+void coin_manager_unload_area(s32 areaIndex);
+s32  coin_manager_add_static_coin(struct Object *coin);
+s32  coin_manager_add_formation_coin(struct Object *formation, s32 index, Vec3f pos, s32 snapToGround);
+void coin_manager_remove_formation(struct Object *formation);
+void coin_manager_collect(struct MarioState *m);
+Gfx *geo_coin_manager_draw(s32 callContext, struct GraphNode *node, void *context);
+
+#endif // COIN_MANAGER
+
+#endif // COIN_MANAGER_H
@@ -0,0 +1,257 @@
+#include <ultra64.h>
+
+#include "sm64.h"
+#include "area.h"
+#include "behavior_data.h"
+#include "effect_pool.h"
+#include "engine/graph_node.h"
+#include "engine/math_util.h"
+#include "game_init.h"
+#include "level_update.h"
+#include "memory.h"
+#include "object_helpers.h"
+#include "object_list_processor.h"
+#include "rendering_graph_node.h"
+
+/**
+ * The effect pool is a fixed pool of small structs for short lived visual
+ * effects such as sparkles and dust. An effect has no behavior script or
+ * graph node of its own, it is moved by a single update function and drawn
+ * as a billboard by one generated display list per render layer, attached
+ * to a single object. This keeps bursts of particles from filling up the
+ * object pool.
+ */
+
+#ifdef EFFECT_POOL
+
+// Effects are never larger than this, used to skip effects behind the camera.
+#define EFFECT_CULLING_RADIUS 100.0f
+
+static struct Effect sEffects[EFFECT_POOL_CAPACITY];
+s32 gNumEffects = 0;
+// The number of effects spawned since the level was loaded, for profiling.
+s32 gNumEffectsSpawned = 0;
+// One past the highest slot in use, so loops don't need to walk the whole array.
+static s32 sEffectsEnd = 0;
+static u8 sNumEffectsInLayer[LAYER_COUNT];
+static struct Object *sEffectPoolObj = NULL;
+
+static struct GraphNodeCullingRadius sEffectPoolCullingNode;
+static struct GraphNodeGenerated     sEffectPoolDrawNodes[LAYER_COUNT];
+
+/**
+ * Reset the pool. Called whenever the object pool is cleared.
+ */
+void effect_pool_clear(void) {
+    bzero(sEffects, sizeof(sEffects));
+    bzero(sNumEffectsInLayer, sizeof(sNumEffectsInLayer));
+    gNumEffects = 0;
+    gNumEffectsSpawned = 0;
+    sEffectsEnd = 0;
+    sEffectPoolObj = NULL;
+}
+
+static void effect_free(struct Effect *effect) {
+    effect->flags = EFFECT_FLAG_NONE;
+    sNumEffectsInLayer[effect->layer]--;
+    gNumEffects--;
+}
+
+/**
+ * Remove every effect that was spawned in the given area. The object that
+ * draws the effects is unloaded alongside the other objects in that area.
+ */
+void effect_pool_unload_area(s32 areaIndex) {
+    struct Effect *effect = sEffects;
+    s32 i;
+
+    for (i = 0; i < sEffectsEnd; i++, effect++) {
+        if ((effect->flags & EFFECT_FLAG_ACTIVE) && effect->areaIndex == areaIndex) {
+            effect_free(effect);
+        }
+    }
+
+    if (sEffectPoolObj != NULL && sEffectPoolObj->header.gfx.areaIndex == areaIndex) {
+        sEffectPoolObj = NULL;
+    }
+}
+
+/**
+ * Spawn the object that draws the effects, if it doesn't exist yet.
+ * It has one generated node for each render layer.
+ */
+static s32 effect_pool_spawn(struct Object *parent) {
+    s32 layer;
+
+    if (sEffectPoolObj != NULL) {
+        return TRUE;
+    }
+
+    if (gFreeObjectList.next == NULL) {
+        return FALSE;
+    }
+
+    init_graph_node_culling_radius(NULL, &sEffectPoolCullingNode, 0x7FFF);
+    for (layer = LAYER_FIRST; layer < LAYER_COUNT; layer++) {
+        init_graph_node_generated(NULL, &sEffectPoolDrawNodes[layer], geo_effect_pool_draw, layer);
+        SET_GRAPH_NODE_LAYER(sEffectPoolDrawNodes[layer].fnNode.node.flags, layer);
+        geo_add_child(&sEffectPoolCullingNode.node, &sEffectPoolDrawNodes[layer].fnNode.node);
+    }
+
+    sEffectPoolObj = spawn_object_abs_with_rot(parent, 0, MODEL_NONE, bhvStaticObject, 0, 0, 0, 0, 0, 0);
+    sEffectPoolObj->parentObj = sEffectPoolObj;
+    sEffectPoolObj->oFlags |= OBJ_FLAG_ACTIVE_FROM_AFAR;
+    sEffectPoolObj->header.gfx.sharedChild = &sEffectPoolCullingNode.node;
+
+    return TRUE;
+}
+
+/**
+ * Spawn an effect at the parent's position, drawn with the given display lists.
+ * Returns NULL if the pool is full, in which case the caller should spawn an object instead.
+ */
+struct Effect *spawn_effect(struct Object *parent, const Gfx *const *frames, s32 layer, EffectUpdateFunc update) {
+    struct Effect *effect = sEffects;
+    s32 i;
+
+    if (gNumEffects >= EFFECT_POOL_CAPACITY || !effect_pool_spawn(parent)) {
+        return NULL;
+    }
+
+    for (i = 0; i < EFFECT_POOL_CAPACITY; i++, effect++) {
+        if (!(effect->flags & EFFECT_FLAG_ACTIVE)) {
+            bzero(effect, sizeof(struct Effect));
+            vec3f_copy(effect->pos, &parent->oPosVec);
+            effect->scale     = 1.0f;
+            effect->update    = update;
+            effect->frames    = frames;
+            effect->flags     = EFFECT_FLAG_ACTIVE;
+            effect->layer     = layer;
+            effect->areaIndex = parent->header.gfx.areaIndex;
+
+            if (i >= sEffectsEnd) {
+                sEffectsEnd = (i + 1);
+            }
+            sNumEffectsInLayer[layer]++;
+            gNumEffects++;
+            gNumEffectsSpawned++;
+
+            return effect;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Spawn an effect using a model that was loaded with LOAD_MODEL_FROM_DL.
+ * Models with a geo layout can't be drawn by the pool, so this returns NULL for them.
+ */
+struct Effect *spawn_effect_with_model(struct Object *parent, ModelID32 model, EffectUpdateFunc update) {
+    struct GraphNodeDisplayList *node = (struct GraphNodeDisplayList *) get_loaded_graph_node(model);
+
+    if (node == NULL || node->node.type != GRAPH_NODE_TYPE_DISPLAY_LIST) {
+        return NULL;
+    }
+
+    return spawn_effect(parent, (const Gfx *const *) &node->displayList, GET_GRAPH_NODE_LAYER(node->node.flags), update);
+}
+
+/**
+ * Update every effect. Effects freeze along with other unimportant objects during time stop.
+ */
+void update_effects(void) {
+    struct Effect *effect = sEffects;
+    s32 i;
+
+    if (gNumEffects == 0 || (gTimeStopState & TIME_STOP_ACTIVE)) {
+        return;
+    }
+
+    for (i = 0; i < sEffectsEnd; i++, effect++) {
+        if (!(effect->flags & EFFECT_FLAG_ACTIVE)) {
+            continue;
+        }
+
+        if (effect->timer < 0) {
+            effect->timer++;
+            continue;
+        }
+
+        if (effect->update(effect)) {
+            effect_free(effect);
+            continue;
+        }
+
+        if (effect->timer < 0x7FFF) {
+            effect->timer++;
+        }
+    }
+
+    // Shrink the active range if the last effects were removed.
+    while (sEffectsEnd > 0 && !(sEffects[sEffectsEnd - 1].flags & EFFECT_FLAG_ACTIVE)) {
+        sEffectsEnd--;
+    }
+}
+
+/**
+ * Draw every visible effect in the node's layer as a billboard.
+ */
+Gfx *geo_effect_pool_draw(s32 callContext, struct GraphNode *node, void *context) {
+    struct GraphNodeGenerated *currentGraphNode = (struct GraphNodeGenerated *) node;
+    s32 layer = currentGraphNode->parameter;
+
+    if (callContext != GEO_CONTEXT_RENDER || sNumEffectsInLayer[layer] == 0 || sEffectPoolObj == NULL) {
+        return NULL;
+    }
+
+    Gfx *dlStart = alloc_display_list(((sNumEffectsInLayer[layer] * 2) + 1) * sizeof(Gfx));
+    Gfx *dlHead  = dlStart;
+
+    if (dlStart == NULL) {
+        return NULL;
+    }
+
+    struct Effect *effect = sEffects;
+    s32 areaIndex = sEffectPoolObj->header.gfx.areaIndex;
+    s32 numDrawn = 0;
+    Vec3f pos, scale;
+    Mat4 mtxf;
+    s32 i;
+
+    for (i = 0; i < sEffectsEnd; i++, effect++) {
+        if (!(effect->flags & EFFECT_FLAG_ACTIVE) || effect->layer != layer
+            || effect->areaIndex != areaIndex || effect->timer < 0) {
+            continue;
+        }
+
+        vec3f_set(pos, effect->pos[0], (effect->pos[1] + effect->graphYOffset), effect->pos[2]);
+        vec3_same(scale, effect->scale);
+        mtxf_billboard(mtxf, context, pos, scale, gCurGraphNodeCamera->roll);
+
+        // Skip effects that are behind the camera, see obj_is_in_view.
+        if (mtxf[3][2] > -100.0f + (EFFECT_CULLING_RADIUS * effect->scale)) {
+            continue;
+        }
+
+        Mtx *effectMtx = alloc_display_list(sizeof(Mtx));
+        if (effectMtx == NULL) {
+            break;
+        }
+
+        mtxf_to_mtx(effectMtx, mtxf);
+        gSPMatrix(dlHead++, VIRTUAL_TO_PHYSICAL(effectMtx), (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+        gSPDisplayList(dlHead++, effect->frames[effect->animState]);
+        numDrawn++;
+    }
+
+    if (numDrawn == 0) {
+        return NULL;
+    }
+
+    gSPEndDisplayList(dlHead);
+
+    return dlStart;
+}
+
+#endif // EFFECT_POOL
@@ -0,0 +1,53 @@
+#ifndef EFFECT_POOL_H
+#define EFFECT_POOL_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+#ifdef EFFECT_POOL
+
+// The maximum number of effects that can exist at once.
+// Any effects past this will fall back to being regular objects.
+#define EFFECT_POOL_CAPACITY 96
+
+struct Effect;
+
+// Called once per frame for each effect. Returns TRUE once the effect should be removed.
+typedef s32 (*EffectUpdateFunc)(struct Effect *effect);
+
+enum EffectFlags {
+    EFFECT_FLAG_NONE   = (0 << 0),
+    EFFECT_FLAG_ACTIVE = (1 << 0),
+};
+
+struct Effect {
+    /*0x00*/ Vec3f pos;
+    /*0x0C*/ Vec3f vel;
+    /*0x18*/ f32 scale;
+    /*0x1C*/ f32 gravity;
+    /*0x20*/ f32 dragStrength;
+    /*0x24*/ f32 graphYOffset;
+    /*0x28*/ EffectUpdateFunc update;
+    /*0x2C*/ const Gfx *const *frames; // Display lists indexed by animState, see geo_switch_anim_state.
+    /*0x30*/ s16 timer; // Effects with a negative timer are neither updated nor drawn until it reaches 0.
+    /*0x32*/ s16 animState;
+    /*0x34*/ u8 flags;
+    /*0x35*/ u8 layer;
+    /*0x36*/ s8 areaIndex;
+    /*0x37*/ u8 pad;
+}; /*0x38*/
+
+extern s32 gNumEffects;
+extern s32 gNumEffectsSpawned;
+
+void effect_pool_clear(void);
+void effect_pool_unload_area(s32 areaIndex);
+struct Effect *spawn_effect(struct Object *parent, const Gfx *const *frames, s32 layer, EffectUpdateFunc update);
+struct Effect *spawn_effect_with_model(struct Object *parent, ModelID32 model, EffectUpdateFunc update);
+void update_effects(void);
+Gfx *geo_effect_pool_draw(s32 callContext, struct GraphNode *node, void *context);
+
+#endif // EFFECT_POOL
+
+#endif // EFFECT_POOL_H
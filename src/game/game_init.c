@@ -10,6 +10,7 @@
 #include "engine/level_script.h"
 #include "engine/math_util.h"
 #include "game_init.h"
+#include "ingame_menu.h"
 #include "main.h"
 #include "memory.h"
 #include "save_file.h"
@@ -172,6 +173,78 @@ void init_z_buffer(s32 resetZB) {
                      SCREEN_HEIGHT - 1 - gBorderHeight);
 }
 
+#ifdef FROZEN_PAUSE_FRAME
+// The number of rows of the screen that fit in TMEM at once.
+#define SCREEN_STRIP_HEIGHT (4096 / (SCREEN_WIDTH * sizeof(RGBA16)))
+
+// Set while the z buffer holds the scene behind the pause menu, see capture_frozen_frame.
+u8 gFrozenFrameCaptured = FALSE;
+
+/**
+ * Whether the z buffer should be kept this frame, because the pause menu
+ * is still open and the z buffer holds the scene behind it.
+ */
+s32 keep_frozen_frame(void) {
+    if (gFrozenFrameCaptured && gMenuMode == MENU_MODE_RENDER_PAUSE_SCREEN) {
+        return TRUE;
+    }
+
+    gFrozenFrameCaptured = FALSE;
+    return FALSE;
+}
+
+/**
+ * Copy a screen sized RGBA16 image into the current color image, a strip of rows at a time.
+ */
+static void copy_screen_image(uintptr_t image) {
+    s32 y, height;
+
+    gDPPipeSync(gDisplayListHead++);
+    gDPSetCycleType(gDisplayListHead++, G_CYC_COPY);
+    gDPSetRenderMode(gDisplayListHead++, G_RM_NOOP, G_RM_NOOP2);
+    gDPSetTexturePersp(gDisplayListHead++, G_TP_NONE);
+    gDPSetTextureFilter(gDisplayListHead++, G_TF_POINT);
+    gDPSetTextureLUT(gDisplayListHead++, G_TT_NONE);
+
+    for (y = 0; y < SCREEN_HEIGHT; y += SCREEN_STRIP_HEIGHT) {
+        height = MIN(SCREEN_STRIP_HEIGHT, (SCREEN_HEIGHT - y));
+
+        gDPLoadSync(gDisplayListHead++);
+        gDPLoadTextureTile(gDisplayListHead++, image, G_IM_FMT_RGBA, G_IM_SIZ_16b, SCREEN_WIDTH, SCREEN_HEIGHT,
+                           0, y, (SCREEN_WIDTH - 1), ((y + height) - 1), 0,
+                           (G_TX_NOMIRROR | G_TX_CLAMP), (G_TX_NOMIRROR | G_TX_CLAMP), G_TX_NOMASK, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOLOD);
+        gSPTextureRectangle(gDisplayListHead++, 0, (y << 2), ((SCREEN_WIDTH - 1) << 2), (((y + height) - 1) << 2),
+                            G_TX_RENDERTILE, 0, (y << 5), (4 << 10), (1 << 10));
+    }
+
+    gDPPipeSync(gDisplayListHead++);
+    gDPSetCycleType(gDisplayListHead++, G_CYC_1CYCLE);
+    gDPSetTexturePersp(gDisplayListHead++, G_TP_PERSP);
+    gDPSetTextureFilter(gDisplayListHead++, G_TF_BILERP);
+}
+
+/**
+ * Copy the scene that was just rendered into the z buffer, which isn't needed
+ * again until the pause menu is closed. Must be called before anything is drawn over the scene.
+ */
+void capture_frozen_frame(void) {
+    gDPPipeSync(gDisplayListHead++);
+    gDPSetColorImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, SCREEN_WIDTH, gPhysicalZBuffer);
+    copy_screen_image(gPhysicalFramebuffers[sRenderingFramebuffer]);
+    gDPSetColorImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, SCREEN_WIDTH,
+                     gPhysicalFramebuffers[sRenderingFramebuffer]);
+
+    gFrozenFrameCaptured = TRUE;
+}
+
+/**
+ * Draw the scene captured by capture_frozen_frame.
+ */
+void draw_frozen_frame(void) {
+    copy_screen_image(gPhysicalZBuffer);
+}
+#endif
+
 /**
  * Tells the RDP which of the three framebuffers it shall draw to.
  */
@@ -432,6 +505,9 @@ void select_gfx_pool(void) {
     gGfxSPTask = &gGfxPool->spTask;
     gDisplayListHead = gGfxPool->buffer;
     gGfxPoolEnd = (u8 *) (gGfxPool->buffer + GFX_POOL_SIZE);
+#ifdef PUPPYPRINT_RDP_MARKERS
+    puppyprint_rdp_markers_reset();
+#endif
 }
 
 /**
@@ -86,6 +86,12 @@ void clear_framebuffer(s32 color);
 void clear_viewport(Vp *viewport, s32 color);
 void make_viewport_clip_rect(Vp *viewport);
 void init_rcp(s32 resetZB);
+#ifdef FROZEN_PAUSE_FRAME
+extern u8 gFrozenFrameCaptured;
+s32 keep_frozen_frame(void);
+void capture_frozen_frame(void);
+void draw_frozen_frame(void);
+#endif
 void end_master_display_list(void);
 void render_init(void);
 void select_gfx_pool(void);
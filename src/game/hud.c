@@ -4,6 +4,7 @@
 #include "actors/common1.h"
 #include "gfx_dimensions.h"
 #include "game_init.h"
+#include "buffers/buffers.h"
 #include "level_update.h"
 #include "camera.h"
 #include "print.h"
@@ -117,6 +118,65 @@ s32 sBreathMeterVisibleTimer = 0;
 
 static struct CameraHUD sCameraHUD = { CAM_STATUS_NONE };
 
+#ifdef RETAINED_HUD
+// Big enough for the longest HUD counter, including EU's two part glyphs.
+#define RETAINED_HUD_LIST_SIZE 80
+// The most keys that fit in a list, more are drawn as text labels.
+#define RETAINED_HUD_MAX_KEYS 4
+
+/**
+ * The display list of a HUD element, which is kept between frames and only
+ * rebuilt when the key describing what it shows changes.
+ */
+struct RetainedHudList {
+    Mtx mtx;
+    Gfx dl[RETAINED_HUD_LIST_SIZE];
+    u32 key;
+    u8 built;
+};
+
+// An element has a list for each gfx pool, since the RCP may still be reading last frame's.
+typedef struct RetainedHudList RetainedHudElement[ARRAY_COUNT(gGfxPools)];
+
+static RetainedHudElement sPowerMeterLists;
+static RetainedHudElement sCameraStatusLists;
+static RetainedHudElement sLivesLists;
+static RetainedHudElement sCoinsLists;
+static RetainedHudElement sStarsLists;
+static RetainedHudElement sKeysLists;
+
+static Gfx *sRetainedHudDisplayListHead;
+
+static struct RetainedHudList *get_retained_hud_list(RetainedHudElement element) {
+    return &element[gGfxPool - gGfxPools];
+}
+
+/**
+ * Returns FALSE if the list was already built with this key. Otherwise everything
+ * drawn until end_retained_hud_list is written into the list instead.
+ */
+static s32 begin_retained_hud_list(struct RetainedHudList *list, u32 key) {
+    if (list->built && list->key == key) {
+        return FALSE;
+    }
+
+    list->key = key;
+    list->built = TRUE;
+
+    sRetainedHudDisplayListHead = gDisplayListHead;
+    gDisplayListHead = list->dl;
+
+    return TRUE;
+}
+
+static void end_retained_hud_list(void) {
+    gSPEndDisplayList(gDisplayListHead++);
+    gDisplayListHead = sRetainedHudDisplayListHead;
+}
+
+#define RETAINED_HUD_KEY(value, x) (((u32)(u16)(value) << 16) | (u16)(x))
+#endif
+
 /**
  * Renders a rgba16 16x16 glyph texture from a table list.
  */
@@ -166,11 +226,21 @@ void render_power_meter_health_segment(s16 numHealthWedges) {
  * That includes the "POWER" base and the colored health segment textures.
  */
 void render_dl_power_meter(s16 numHealthWedges) {
+#ifdef RETAINED_HUD
+    struct RetainedHudList *list = get_retained_hud_list(sPowerMeterLists);
+    Mtx *mtx = &list->mtx;
+
+    if (!begin_retained_hud_list(list, RETAINED_HUD_KEY(numHealthWedges, sPowerMeterHUD.y))) {
+        gSPDisplayList(gDisplayListHead++, list->dl);
+        return;
+    }
+#else
     Mtx *mtx = alloc_display_list(sizeof(Mtx));
 
     if (mtx == NULL) {
         return;
     }
+#endif
 
     guTranslate(mtx, (f32) sPowerMeterHUD.x, (f32) sPowerMeterHUD.y, 0);
 
@@ -185,6 +255,10 @@ void render_dl_power_meter(s16 numHealthWedges) {
     }
 
     gSPPopMatrix(gDisplayListHead++, G_MTX_MODELVIEW);
+#ifdef RETAINED_HUD
+    end_retained_hud_list();
+    gSPDisplayList(gDisplayListHead++, list->dl);
+#endif
 }
 
 /**
@@ -394,9 +468,26 @@ void render_hud_breath_meter(void) {
  * Renders the amount of lives Mario has.
  */
 void render_hud_mario_lives(void) {
+#ifdef RETAINED_HUD
+    struct RetainedHudList *list = get_retained_hud_list(sLivesLists);
+    char text[12];
+
+    if (begin_retained_hud_list(list, RETAINED_HUD_KEY(gHudDisplay.lives, GFX_DIMENSIONS_RECT_FROM_LEFT_EDGE(22)))) {
+        sprintf(text, "%d", gHudDisplay.lives);
+        gSPDisplayList(gDisplayListHead++, dl_hud_img_begin);
+        render_text_glyphs(GFX_DIMENSIONS_RECT_FROM_LEFT_EDGE(22), HUD_TOP_Y, ","); // 'Mario Head' glyph
+        render_text_glyphs(GFX_DIMENSIONS_RECT_FROM_LEFT_EDGE(38), HUD_TOP_Y, "*"); // 'X' glyph
+        render_text_glyphs(GFX_DIMENSIONS_RECT_FROM_LEFT_EDGE(54), HUD_TOP_Y, text);
+        gSPDisplayList(gDisplayListHead++, dl_hud_img_end);
+        end_retained_hud_list();
+    }
+
+    gSPDisplayList(gDisplayListHead++, list->dl);
+#else
     print_text(GFX_DIMENSIONS_RECT_FROM_LEFT_EDGE(22), HUD_TOP_Y, ","); // 'Mario Head' glyph
     print_text(GFX_DIMENSIONS_RECT_FROM_LEFT_EDGE(38), HUD_TOP_Y, "*"); // 'X' glyph
     print_text_fmt_int(GFX_DIMENSIONS_RECT_FROM_LEFT_EDGE(54), HUD_TOP_Y, "%d", gHudDisplay.lives);
+#endif
 }
 
 #ifdef VANILLA_STYLE_CUSTOM_DEBUG
@@ -415,9 +506,26 @@ void render_debug_mode(void) {
  * Renders the amount of coins collected.
  */
 void render_hud_coins(void) {
+#ifdef RETAINED_HUD
+    struct RetainedHudList *list = get_retained_hud_list(sCoinsLists);
+    char text[12];
+
+    if (begin_retained_hud_list(list, RETAINED_HUD_KEY(gHudDisplay.coins, 0))) {
+        sprintf(text, "%d", gHudDisplay.coins);
+        gSPDisplayList(gDisplayListHead++, dl_hud_img_begin);
+        render_text_glyphs(168, HUD_TOP_Y, "$"); // 'Coin' glyph
+        render_text_glyphs(184, HUD_TOP_Y, "*"); // 'X' glyph
+        render_text_glyphs(198, HUD_TOP_Y, text);
+        gSPDisplayList(gDisplayListHead++, dl_hud_img_end);
+        end_retained_hud_list();
+    }
+
+    gSPDisplayList(gDisplayListHead++, list->dl);
+#else
     print_text(168, HUD_TOP_Y, "$"); // 'Coin' glyph
     print_text(184, HUD_TOP_Y, "*"); // 'X' glyph
     print_text_fmt_int(198, HUD_TOP_Y, "%d", gHudDisplay.coins);
+#endif
 }
 
 #define HUD_STARS_X 78
@@ -429,10 +537,27 @@ void render_hud_coins(void) {
 void render_hud_stars(void) {
     if (gHudFlash == HUD_FLASH_STARS && gGlobalTimer & 0x8) return;
     s8 showX = (gHudDisplay.stars < 100);
+#ifdef RETAINED_HUD
+    struct RetainedHudList *list = get_retained_hud_list(sStarsLists);
+    char text[12];
+
+    if (begin_retained_hud_list(list, RETAINED_HUD_KEY(gHudDisplay.stars, GFX_DIMENSIONS_RECT_FROM_RIGHT_EDGE(HUD_STARS_X)))) {
+        sprintf(text, "%d", gHudDisplay.stars);
+        gSPDisplayList(gDisplayListHead++, dl_hud_img_begin);
+        render_text_glyphs(GFX_DIMENSIONS_RECT_FROM_RIGHT_EDGE(HUD_STARS_X), HUD_TOP_Y, "^"); // 'Star' glyph
+        if (showX) render_text_glyphs((GFX_DIMENSIONS_RECT_FROM_RIGHT_EDGE(HUD_STARS_X) + 16), HUD_TOP_Y, "*"); // 'X' glyph
+        render_text_glyphs((showX * 14) + GFX_DIMENSIONS_RECT_FROM_RIGHT_EDGE(HUD_STARS_X - 16), HUD_TOP_Y, text);
+        gSPDisplayList(gDisplayListHead++, dl_hud_img_end);
+        end_retained_hud_list();
+    }
+
+    gSPDisplayList(gDisplayListHead++, list->dl);
+#else
     print_text(GFX_DIMENSIONS_RECT_FROM_RIGHT_EDGE(HUD_STARS_X), HUD_TOP_Y, "^"); // 'Star' glyph
     if (showX) print_text((GFX_DIMENSIONS_RECT_FROM_RIGHT_EDGE(HUD_STARS_X) + 16), HUD_TOP_Y, "*"); // 'X' glyph
     print_text_fmt_int((showX * 14) + GFX_DIMENSIONS_RECT_FROM_RIGHT_EDGE(HUD_STARS_X - 16),
                        HUD_TOP_Y, "%d", gHudDisplay.stars);
+#endif
 }
 
 /**
@@ -442,6 +567,23 @@ void render_hud_stars(void) {
 void render_hud_keys(void) {
     s16 i;
 
+#ifdef RETAINED_HUD
+    if (gHudDisplay.keys <= RETAINED_HUD_MAX_KEYS) {
+        struct RetainedHudList *list = get_retained_hud_list(sKeysLists);
+
+        if (begin_retained_hud_list(list, RETAINED_HUD_KEY(gHudDisplay.keys, 0))) {
+            gSPDisplayList(gDisplayListHead++, dl_hud_img_begin);
+            for (i = 0; i < gHudDisplay.keys; i++) {
+                render_text_glyphs((i * 16) + 220, 142, "|"); // unused glyph - beta key
+            }
+            gSPDisplayList(gDisplayListHead++, dl_hud_img_end);
+            end_retained_hud_list();
+        }
+
+        gSPDisplayList(gDisplayListHead++, list->dl);
+        return;
+    }
+#endif
     for (i = 0; i < gHudDisplay.keys; i++) {
         print_text((i * 16) + 220, 142, "|"); // unused glyph - beta key
     }
@@ -498,6 +640,15 @@ void render_hud_camera_status(void) {
         return;
     }
 
+#ifdef RETAINED_HUD
+    struct RetainedHudList *list = get_retained_hud_list(sCameraStatusLists);
+
+    if (!begin_retained_hud_list(list, RETAINED_HUD_KEY(sCameraHUD.status, x))) {
+        gSPDisplayList(gDisplayListHead++, list->dl);
+        return;
+    }
+#endif
+
     gSPDisplayList(gDisplayListHead++, dl_hud_img_begin);
     render_hud_tex_lut(x, y, (*cameraLUT)[GLYPH_CAM_CAMERA]);
 
@@ -523,6 +674,10 @@ void render_hud_camera_status(void) {
     }
 
     gSPDisplayList(gDisplayListHead++, dl_hud_img_end);
+#ifdef RETAINED_HUD
+    end_retained_hud_list();
+    gSPDisplayList(gDisplayListHead++, list->dl);
+#endif
 }
 
 /**
@@ -563,20 +718,6 @@ void render_hud(void) {
             render_hud_cannon_reticle();
         }
 
-#ifndef DISABLE_LIVES
-        if (hudDisplayFlags & HUD_DISPLAY_FLAG_LIVES) {
-            render_hud_mario_lives();
-        }
-#endif
-
-        if (hudDisplayFlags & HUD_DISPLAY_FLAG_COIN_COUNT) {
-            render_hud_coins();
-        }
-
-        if (hudDisplayFlags & HUD_DISPLAY_FLAG_STAR_COUNT) {
-            render_hud_stars();
-        }
-
         if (hudDisplayFlags & HUD_DISPLAY_FLAG_KEYS) {
             render_hud_keys();
         }
@@ -600,6 +741,22 @@ void render_hud(void) {
             render_hud_timer();
         }
 
+        // Drawn after the power meter so that with RETAINED_HUD, where they are drawn right away
+        // instead of as text labels, they still end up on top of it.
+#ifndef DISABLE_LIVES
+        if (hudDisplayFlags & HUD_DISPLAY_FLAG_LIVES) {
+            render_hud_mario_lives();
+        }
+#endif
+
+        if (hudDisplayFlags & HUD_DISPLAY_FLAG_COIN_COUNT) {
+            render_hud_coins();
+        }
+
+        if (hudDisplayFlags & HUD_DISPLAY_FLAG_STAR_COUNT) {
+            render_hud_stars();
+        }
+
         if (gSurfacePoolError & NOT_ENOUGH_ROOM_FOR_SURFACES) print_text(10, 40, "SURFACE POOL FULL");
         if (gSurfacePoolError & NOT_ENOUGH_ROOM_FOR_NODES) print_text(10, 60, "SURFACE NODE POOL FULL");
 
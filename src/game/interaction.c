@@ -6,6 +6,7 @@
 #include "behavior_actions.h"
 #include "behavior_data.h"
 #include "camera.h"
+#include "coin_manager.h"
 #include "course_table.h"
 #include "dialog_ids.h"
 #include "engine/math_util.h"
@@ -727,25 +728,33 @@ void reset_mario_pitch(struct MarioState *m) {
     }
 }
 
-u32 interact_coin(struct MarioState *m, UNUSED u32 interactType, struct Object *obj) {
-    m->numCoins += obj->oDamageOrCoinValue;
-    m->healCounter += 4 * obj->oDamageOrCoinValue;
+/**
+ * Give Mario the given number of coins, healing him and spawning the 100 coin star if needed.
+ * Must be called while Mario is the current object, since the star spawns at 'o'.
+ */
+void mario_add_coins(struct MarioState *m, s32 numCoins) {
+    m->numCoins += numCoins;
+    m->healCounter += 4 * numCoins;
 #ifdef BREATH_METER
-    m->breathCounter += (4 * obj->oDamageOrCoinValue);
+    m->breathCounter += (4 * numCoins);
 #endif
-    obj->oInteractStatus = INT_STATUS_INTERACTED;
 
 #ifdef X_COIN_STAR
-    if (COURSE_IS_MAIN_COURSE(gCurrCourseNum) && m->numCoins - obj->oDamageOrCoinValue < X_COIN_STAR
+    if (COURSE_IS_MAIN_COURSE(gCurrCourseNum) && m->numCoins - numCoins < X_COIN_STAR
         && m->numCoins >= X_COIN_STAR) {
         bhv_spawn_star_no_level_exit(STAR_BP_ACT_100_COINS);
     }
 #endif
 #if ENABLE_RUMBLE
-    if (obj->oDamageOrCoinValue >= 2) {
+    if (numCoins >= 2) {
         queue_rumble_data(5, 80);
     }
 #endif
+}
+
+u32 interact_coin(struct MarioState *m, UNUSED u32 interactType, struct Object *obj) {
+    obj->oInteractStatus = INT_STATUS_INTERACTED;
+    mario_add_coins(m, obj->oDamageOrCoinValue);
 
     return FALSE;
 }
@@ -1826,6 +1835,12 @@ void mario_process_interactions(struct MarioState *m) {
         }
     }
 
+#ifdef COIN_MANAGER
+    if (!(m->action & ACT_FLAG_INTANGIBLE)) {
+        coin_manager_collect(m);
+    }
+#endif
+
     if (m->invincTimer > 0 && !sDelayInvincTimer) {
         m->invincTimer--;
     }
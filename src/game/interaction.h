@@ -137,6 +137,7 @@ void mario_retrieve_cap(void);
 struct Object *mario_get_collided_object(struct MarioState *m, u32 interactType);
 u32  mario_check_object_grab(struct MarioState *m);
 u32  get_door_save_file_flag(struct Object *door);
+void mario_add_coins(struct MarioState *m, s32 numCoins);
 void mario_process_interactions(struct MarioState *m);
 void mario_handle_special_floors(struct MarioState *m);
 
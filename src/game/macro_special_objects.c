@@ -247,6 +247,72 @@ void spawn_special_objects(s32 areaIndex, TerrainData **specialObjList) {
     }
 }
 
+#ifdef LAZY_MODEL_LOADING
+/**
+ * Build the models of the objects in a macro object list ahead of time.
+ * Lists for spawn_macro_objects_hardcoded are left alone, their models are built as they spawn.
+ */
+void build_macro_object_models(MacroObject *macroObjList) {
+    s32 presetID;
+
+    if (0 <= *macroObjList && *macroObjList < 30) {
+        return;
+    }
+
+    while (*macroObjList != -1) {
+        presetID = (*macroObjList & 0x1FF) - 31;
+
+        if (presetID < 0) {
+            break;
+        }
+
+        get_loaded_graph_node(MacroObjectPresets[presetID].model);
+        macroObjList += 5;
+    }
+}
+
+/**
+ * Build the models of the objects in a special object list ahead of time, moving the list past them.
+ */
+void build_special_object_models(TerrainData **specialObjList) {
+    s32 i;
+    s32 offset;
+    u8 presetID;
+
+    s32 numOfSpecialObjects = *(*specialObjList)++;
+
+    for (i = 0; i < numOfSpecialObjects; i++) {
+        presetID = *(*specialObjList)++;
+        *specialObjList += 3;
+
+        offset = 0;
+        while (TRUE) {
+            if (SpecialObjectPresets[offset].preset_id == presetID) {
+                break;
+            }
+            offset++;
+        }
+
+        get_loaded_graph_node(SpecialObjectPresets[offset].model);
+
+        switch (SpecialObjectPresets[offset].type) {
+            case SPTYPE_YROT_NO_PARAMS:
+            case SPTYPE_DEF_PARAM_AND_YROT:
+                (*specialObjList)++;
+                break;
+            case SPTYPE_PARAMS_AND_YROT:
+                *specialObjList += 2;
+                break;
+            case SPTYPE_UNKNOWN:
+                *specialObjList += 3;
+                break;
+            default:
+                break;
+        }
+    }
+}
+#endif
+
 #ifdef NO_SEGMENTED_MEMORY
 u32 get_special_objects_size(s16 *data) {
     s16 *startPos = data;
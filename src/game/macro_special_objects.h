@@ -14,6 +14,10 @@ void spawn_macro_abs_special(ModelID32 model, const BehaviorScript *behavior, s1
 void spawn_macro_objects(s32 areaIndex, MacroObject *macroObjList);
 void spawn_macro_objects_hardcoded(s32 areaIndex, MacroObject *macroObjList);
 void spawn_special_objects(s32 areaIndex, TerrainData **specialObjList);
+#ifdef LAZY_MODEL_LOADING
+void build_macro_object_models(MacroObject *macroObjList);
+void build_special_object_models(TerrainData **specialObjList);
+#endif
 #ifdef NO_SEGMENTED_MEMORY
 u32 get_special_objects_size(s16 *data);
 #endif
@@ -40,6 +40,32 @@ struct DmaHandlerList {
 
 #define EFFECTS_MEMORY_POOL 0x4000
 
+#ifdef LEVEL_LOAD_PLANS
+enum LoadJobTypes {
+    LOAD_JOB_RAW,
+    LOAD_JOB_COMPRESSED,
+    LOAD_JOB_COMPRESSED_HEAP, // Decompressed into gDecompressionHeap, like LOAD_YAY0_TEXTURE.
+};
+
+struct LoadJob {
+    u8 type;
+    u8 segment;
+    u8 *srcStart;
+    u8 *srcEnd;
+    u8 *bssStart;
+    u8 *bssEnd;
+};
+
+// The most segments loaded by one plan, any loads after this start a new plan.
+#define LOAD_PLAN_MAX_JOBS 16
+
+// A run of segment loads from a level script, see load_plan_execute.
+struct LoadPlan {
+    struct LoadJob jobs[LOAD_PLAN_MAX_JOBS];
+    s32 numJobs;
+};
+#endif
+
 extern struct MemoryPool *gEffectsMemoryPool;
 
 uintptr_t set_segment_base_addr(s32 segment, void *addr);
@@ -62,6 +88,9 @@ void *load_to_fixed_pool_addr(u8 *destAddr, u8 *srcStart, u8 *srcEnd);
 void *load_segment_decompress(s32 segment, u8 *srcStart, u8 *srcEnd);
 void *load_segment_decompress_heap(u32 segment, u8 *srcStart, u8 *srcEnd);
 void load_engine_code_segment(void);
+#ifdef LEVEL_LOAD_PLANS
+s32 load_plan_execute(struct LoadPlan *plan);
+#endif
 #else
 #define load_segment(...)
 #define load_to_fixed_pool_addr(...)
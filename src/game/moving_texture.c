@@ -13,6 +13,7 @@
 #include "geo_misc.h"
 #include "rendering_graph_node.h"
 #include "object_list_processor.h"
+#include "game_init.h"
 
 /**
  * This file contains functions for generating display lists with moving textures
@@ -345,23 +346,38 @@ struct MovtexQuad {
 /// Variable for a little optimization: only set the texture when it differs from the previous texture
 s16 gMovetexLastTextureId;
 
+#ifdef GEO_MEMOIZATION
+/// While a water region list is built for the cache, where the vertices of each quad are recorded
+static Vtx **sMovtexQuadVertsHead = NULL;
+#endif
+
+/**
+ * Advance the texture rotation of a quad, and write its vertices at height y.
+ */
+static void movtex_write_quad_verts(Vtx *verts, s16 y, struct MovtexQuad *quad) {
+    s16 rot;
+
+    if (gMovtexCounter != gMovtexCounterPrev) {
+        quad->rot += quad->rotspeed;
+    }
+    rot = quad->rot;
+    if (quad->rotDir == ROTATE_CLOCKWISE) {
+        movtex_make_quad_vertex(verts, 0, quad->x1, y, quad->z1, rot,  0x0000, quad->scale, quad->alpha);
+        movtex_make_quad_vertex(verts, 1, quad->x2, y, quad->z2, rot,  0x4000, quad->scale, quad->alpha);
+        movtex_make_quad_vertex(verts, 2, quad->x3, y, quad->z3, rot, -0x8000, quad->scale, quad->alpha);
+        movtex_make_quad_vertex(verts, 3, quad->x4, y, quad->z4, rot, -0x4000, quad->scale, quad->alpha);
+    } else { // ROTATE_COUNTER_CLOCKWISE
+        movtex_make_quad_vertex(verts, 0, quad->x1, y, quad->z1, rot,  0x0000, quad->scale, quad->alpha);
+        movtex_make_quad_vertex(verts, 1, quad->x2, y, quad->z2, rot, -0x4000, quad->scale, quad->alpha);
+        movtex_make_quad_vertex(verts, 2, quad->x3, y, quad->z3, rot, -0x8000, quad->scale, quad->alpha);
+        movtex_make_quad_vertex(verts, 3, quad->x4, y, quad->z4, rot,  0x4000, quad->scale, quad->alpha);
+    }
+}
+
 /**
  * Generates and returns a display list for a single MovtexQuad at height y.
  */
 Gfx *movtex_gen_from_quad(s16 y, struct MovtexQuad *quad) {
-    s16 rot;
-    s16 rotspeed = quad->rotspeed;
-    s16 scale = quad->scale;
-    s16 x1 = quad->x1;
-    s16 z1 = quad->z1;
-    s16 x2 = quad->x2;
-    s16 z2 = quad->z2;
-    s16 x3 = quad->x3;
-    s16 z3 = quad->z3;
-    s16 x4 = quad->x4;
-    s16 z4 = quad->z4;
-    s16 rotDir = quad->rotDir;
-    s16 alpha = quad->alpha;
     s16 textureId = quad->textureId;
     Vtx *verts = alloc_display_list(4 * sizeof(*verts));
     Gfx *gfxHead;
@@ -377,21 +393,12 @@ Gfx *movtex_gen_from_quad(s16 y, struct MovtexQuad *quad) {
         return NULL;
     }
     gfx = gfxHead;
-    if (gMovtexCounter != gMovtexCounterPrev) {
-        quad->rot += rotspeed;
-    }
-    rot = quad->rot;
-    if (rotDir == ROTATE_CLOCKWISE) {
-        movtex_make_quad_vertex(verts, 0, x1, y, z1, rot,  0x0000, scale, alpha);
-        movtex_make_quad_vertex(verts, 1, x2, y, z2, rot,  0x4000, scale, alpha);
-        movtex_make_quad_vertex(verts, 2, x3, y, z3, rot, -0x8000, scale, alpha);
-        movtex_make_quad_vertex(verts, 3, x4, y, z4, rot, -0x4000, scale, alpha);
-    } else { // ROTATE_COUNTER_CLOCKWISE
-        movtex_make_quad_vertex(verts, 0, x1, y, z1, rot,  0x0000, scale, alpha);
-        movtex_make_quad_vertex(verts, 1, x2, y, z2, rot, -0x4000, scale, alpha);
-        movtex_make_quad_vertex(verts, 2, x3, y, z3, rot, -0x8000, scale, alpha);
-        movtex_make_quad_vertex(verts, 3, x4, y, z4, rot,  0x4000, scale, alpha);
+    movtex_write_quad_verts(verts, y, quad);
+#ifdef GEO_MEMOIZATION
+    if (sMovtexQuadVertsHead != NULL) {
+        *sMovtexQuadVertsHead++ = verts;
     }
+#endif
 
     // Only add commands to change the texture when necessary
     if (textureId != gMovetexLastTextureId) {
@@ -461,6 +468,69 @@ Gfx *movtex_gen_quads_id(s16 id, s16 y, void *movetexQuadsSegmented) {
     return NULL;
 }
 
+#ifdef GEO_MEMOIZATION
+/**
+ * Same search as movtex_gen_quads_id, but returns the quad array itself,
+ * where the first number is the number of quads that follow it.
+ */
+static s16 *movtex_find_quad_array(s16 id, void *movetexQuadsSegmented) {
+    struct MovtexQuadCollection *collection = segmented_to_virtual(movetexQuadsSegmented);
+    s32 i = 0;
+
+    while (collection[i].id != -1) {
+        if (collection[i].id == id) {
+            return segmented_to_virtual(collection[i].quadArraySegmented);
+        }
+        i++;
+    }
+    return NULL;
+}
+
+/**
+ * The most memory that geo_movtex_draw_water_regions can allocate for the quad collection,
+ * and the number of quads it draws.
+ */
+static u32 movtex_water_regions_size(void *quadCollection, s32 *numQuads) {
+    s16 numWaterBoxes = gEnvironmentRegions[0];
+    u32 size = ((numWaterBoxes + 3) * sizeof(Gfx));
+    s16 *quadArr;
+    s32 i;
+
+    *numQuads = 0;
+    for (i = 0; i < numWaterBoxes; i++) {
+        quadArr = movtex_find_quad_array(gEnvironmentRegions[i * 6 + 1], quadCollection);
+        if (quadArr != NULL) {
+            // movtex_gen_from_quad_array, then 4 vertices and up to 8 commands for each quad
+            size += ((quadArr[0] + 1) * sizeof(Gfx)) + (quadArr[0] * ((4 * sizeof(Vtx)) + (8 * sizeof(Gfx))));
+            *numQuads += quadArr[0];
+        }
+    }
+    // alloc_display_list rounds up to 8 bytes
+    return (size + ((((*numQuads + 1) * sizeof(Vtx *)) + 7) & ~7));
+}
+
+/**
+ * Write the vertices of every quad of a cached water region list again, in the order they were built.
+ */
+static void movtex_update_water_regions(void *quadCollection, Vtx **quadVerts) {
+    s16 numWaterBoxes = gEnvironmentRegions[0];
+    s16 *quadArr;
+    s32 i, j;
+
+    for (i = 0; i < numWaterBoxes; i++) {
+        quadArr = movtex_find_quad_array(gEnvironmentRegions[i * 6 + 1], quadCollection);
+        if (quadArr == NULL) {
+            continue;
+        }
+        for (j = 0; j < quadArr[0] && *quadVerts != NULL; j++) {
+            // quadArr is an array of s16, so sizeof(MovtexQuad) gets divided by 2
+            movtex_write_quad_verts(*quadVerts++, gEnvironmentRegions[i * 6 + 6],
+                                    (struct MovtexQuad *) (&quadArr[j * (sizeof(struct MovtexQuad) / 2) + 1]));
+        }
+    }
+}
+#endif
+
 extern Movtex bbh_movtex_merry_go_round_water_entrance[];
 extern Movtex bbh_movtex_merry_go_round_water_side[];
 extern Movtex ccm_movtex_penguin_puddle_water[];
@@ -580,6 +650,10 @@ Gfx *geo_movtex_draw_water_regions(s32 callContext, struct GraphNode *node, UNUS
     s16 waterId;
     s16 waterY;
     s32 i;
+#ifdef GEO_MEMOIZATION
+    Vtx **quadVerts = NULL;
+    s32 numQuads;
+#endif
 
     if (callContext == GEO_CONTEXT_RENDER) {
         gMovtexVtxColor = MOVTEX_VTX_COLOR_DEFAULT;
@@ -587,12 +661,6 @@ Gfx *geo_movtex_draw_water_regions(s32 callContext, struct GraphNode *node, UNUS
             return NULL;
         }
         numWaterBoxes = gEnvironmentRegions[0];
-        gfxHead = alloc_display_list((numWaterBoxes + 3) * sizeof(*gfxHead));
-        if (gfxHead == NULL) {
-            return NULL;
-        } else {
-            gfx = gfxHead;
-        }
         asGenerated = (struct GraphNodeGenerated *) node;
         if (asGenerated->parameter == JRB_MOVTEX_INITIAL_MIST) {
             if (gLakituState.goalPos[1] < 1024.0f) { // if camera under water
@@ -613,6 +681,34 @@ Gfx *geo_movtex_draw_water_regions(s32 callContext, struct GraphNode *node, UNUS
 
         SET_GRAPH_NODE_LAYER(asGenerated->fnNode.node.flags, LAYER_TRANSPARENT_INTER);
 
+#ifdef GEO_MEMOIZATION
+        // The list only changes with the water levels, so it is kept and only the vertices of its quads are written
+        // again for the texture rotation. Alternate frames use their own copy, since last frame's may still be drawn.
+        gfxHead = geo_memo_begin(node, (gGlobalTimer & 1), gEnvironmentRegions, ((numWaterBoxes * 6 + 1) * sizeof(s16)),
+                                 movtex_water_regions_size(quadCollection, &numQuads), (void **) &quadVerts);
+        if (gfxHead != NULL) {
+            movtex_update_water_regions(quadCollection, quadVerts);
+            return gfxHead;
+        }
+        quadVerts = alloc_display_list((numQuads + 1) * sizeof(Vtx *));
+        if (quadVerts == NULL) {
+            return geo_memo_end(NULL, NULL);
+        }
+        bzero(quadVerts, ((numQuads + 1) * sizeof(Vtx *)));
+        sMovtexQuadVertsHead = quadVerts;
+#endif
+        gfxHead = alloc_display_list((numWaterBoxes + 3) * sizeof(*gfxHead));
+        if (gfxHead == NULL) {
+#ifdef GEO_MEMOIZATION
+            sMovtexQuadVertsHead = NULL;
+            return geo_memo_end(NULL, NULL);
+#else
+            return NULL;
+#endif
+        } else {
+            gfx = gfxHead;
+        }
+
         movtex_change_texture_format(asGenerated->parameter, &gfx);
         gMovetexLastTextureId = -1;
         for (i = 0; i < numWaterBoxes; i++) {
@@ -624,6 +720,10 @@ Gfx *geo_movtex_draw_water_regions(s32 callContext, struct GraphNode *node, UNUS
         }
         gSPDisplayList(gfx++, dl_waterbox_end);
         gSPEndDisplayList(gfx);
+#ifdef GEO_MEMOIZATION
+        sMovtexQuadVertsHead = NULL;
+        gfxHead = geo_memo_end(gfxHead, quadVerts);
+#endif
     }
     return gfxHead;
 }
@@ -133,7 +133,7 @@ s8 obj_find_wall(f32 objNewX, f32 objY, f32 objNewZ, f32 objVelX, f32 objVelZ) {
     hitbox.offsetY = o->hitboxHeight / 2;
     hitbox.radius = o->hitboxRadius;
 
-    if (find_wall_collisions(&hitbox) != 0) {
+    if (find_wall_collisions_with_clearance(&hitbox, &o->wallClearance) != 0) {
         o->oPosX = hitbox.x;
         o->oPosY = hitbox.y;
         o->oPosZ = hitbox.z;
@@ -3,6 +3,7 @@
 #include "sm64.h"
 #include "actors/common0.h"
 #include "actors/group11.h"
+#include "actors/group14.h"
 #include "actors/group17.h"
 #include "audio/external.h"
 #include "behavior_actions.h"
@@ -40,6 +41,7 @@
 #include "object_constants.h"
 #include "object_helpers.h"
 #include "object_list_processor.h"
+#include "path_cache.h"
 #include "platform_displacement.h"
 #include "rendering_graph_node.h"
 #include "save_file.h"
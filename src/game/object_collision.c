@@ -162,6 +162,125 @@ void check_destructive_object_collision(void) {
     }
 }
 
+#ifdef COMPACT_OBJECT_COLLISION
+/**
+ * A compact copy of the fields the collision checks read, built once per frame.
+ * Walking these instead of the object lists means each pair of objects tested
+ * only touches a few bytes, rather than pulling both whole objects through the
+ * data cache. Objects are only read when their hitboxes actually overlap.
+ */
+struct ObjectHitboxCache {
+    /*0x00*/ f32 posX;
+    /*0x04*/ f32 bottom;
+    /*0x08*/ f32 posZ;
+    /*0x0C*/ f32 radius;
+    /*0x10*/ f32 height;
+    /*0x14*/ struct Object *obj;
+}; /*0x18*/
+
+static struct ObjectHitboxCache sHitboxCache[OBJECT_POOL_CAPACITY];
+static struct ObjectHitboxCache *sHitboxCacheStart[NUM_OBJ_LISTS];
+static struct ObjectHitboxCache *sHitboxCacheEnd[NUM_OBJ_LISTS];
+static s32 sNumCachedHitboxes;
+
+/**
+ * Same as clear_object_collision, but also caches the hitboxes of every tangible object in the list.
+ * The cache keeps the list order, so objects are tested in the same order as before.
+ */
+static void clear_and_cache_object_collision(s32 listIndex) {
+    struct Object *listHead = (struct Object *) &gObjectLists[listIndex];
+    struct Object *nextObj = (struct Object *) listHead->header.next;
+    struct ObjectHitboxCache *entry = &sHitboxCache[sNumCachedHitboxes];
+
+    sHitboxCacheStart[listIndex] = entry;
+
+    while (nextObj != listHead) {
+        nextObj->numCollidedObjs = 0;
+        nextObj->collidedObjInteractTypes = 0;
+        if (nextObj->oIntangibleTimer > 0) {
+            nextObj->oIntangibleTimer--;
+        }
+
+        if (nextObj->oIntangibleTimer == 0 && sNumCachedHitboxes < OBJECT_POOL_CAPACITY) {
+            entry->posX   = nextObj->oPosX;
+            entry->bottom = nextObj->oPosY - nextObj->hitboxDownOffset;
+            entry->posZ   = nextObj->oPosZ;
+            entry->radius = nextObj->hitboxRadius;
+            entry->height = nextObj->hitboxHeight;
+            entry->obj    = nextObj;
+            entry++;
+            sNumCachedHitboxes++;
+        }
+
+        nextObj = (struct Object *) nextObj->header.next;
+    }
+
+    sHitboxCacheEnd[listIndex] = entry;
+}
+
+/**
+ * Same as check_collision_in_list, using the hitbox cache. Every cached object is tangible.
+ */
+static void check_collision_in_cache(struct ObjectHitboxCache *a, struct ObjectHitboxCache *b, struct ObjectHitboxCache *end) {
+    for (; b < end; b++) {
+        f32 dx = a->posX - b->posX;
+        f32 dz = a->posZ - b->posZ;
+
+        if (sqr(a->radius + b->radius) <= (sqr(dx) + sqr(dz))
+            || a->bottom > (b->bottom + b->height)
+            || (a->bottom + a->height) < b->bottom) {
+            continue;
+        }
+
+        if (detect_object_hitbox_overlap(a->obj, b->obj) && b->obj->hurtboxRadius != 0.0f) {
+            detect_object_hurtbox_overlap(a->obj, b->obj);
+        }
+    }
+}
+
+static void check_collision_in_cached_list(struct ObjectHitboxCache *a, s32 listIndex) {
+    check_collision_in_cache(a, sHitboxCacheStart[listIndex], sHitboxCacheEnd[listIndex]);
+}
+
+void detect_object_collisions(void) {
+    struct ObjectHitboxCache *a;
+
+    sNumCachedHitboxes = 0;
+    clear_and_cache_object_collision(OBJ_LIST_POLELIKE);
+    clear_and_cache_object_collision(OBJ_LIST_PLAYER);
+    clear_and_cache_object_collision(OBJ_LIST_PUSHABLE);
+    clear_and_cache_object_collision(OBJ_LIST_GENACTOR);
+    clear_and_cache_object_collision(OBJ_LIST_LEVEL);
+    clear_and_cache_object_collision(OBJ_LIST_SURFACE);
+    clear_and_cache_object_collision(OBJ_LIST_DESTRUCTIVE);
+
+    // See check_player_object_collision.
+    for (a = sHitboxCacheStart[OBJ_LIST_PLAYER]; a < sHitboxCacheEnd[OBJ_LIST_PLAYER]; a++) {
+        check_collision_in_cache(a, (a + 1), sHitboxCacheEnd[OBJ_LIST_PLAYER]);
+        check_collision_in_cached_list(a, OBJ_LIST_POLELIKE);
+        check_collision_in_cached_list(a, OBJ_LIST_LEVEL);
+        check_collision_in_cached_list(a, OBJ_LIST_GENACTOR);
+        check_collision_in_cached_list(a, OBJ_LIST_PUSHABLE);
+        check_collision_in_cached_list(a, OBJ_LIST_SURFACE);
+        check_collision_in_cached_list(a, OBJ_LIST_DESTRUCTIVE);
+    }
+
+    // See check_destructive_object_collision.
+    for (a = sHitboxCacheStart[OBJ_LIST_DESTRUCTIVE]; a < sHitboxCacheEnd[OBJ_LIST_DESTRUCTIVE]; a++) {
+        if (a->obj->oDistanceToMario < 2000.0f && !(a->obj->activeFlags & ACTIVE_FLAG_DESTRUCTIVE_OBJ_DONT_DESTROY)) {
+            check_collision_in_cache(a, (a + 1), sHitboxCacheEnd[OBJ_LIST_DESTRUCTIVE]);
+            check_collision_in_cached_list(a, OBJ_LIST_GENACTOR);
+            check_collision_in_cached_list(a, OBJ_LIST_PUSHABLE);
+            check_collision_in_cached_list(a, OBJ_LIST_SURFACE);
+        }
+    }
+
+    // See check_pushable_object_collision.
+    for (a = sHitboxCacheStart[OBJ_LIST_PUSHABLE]; a < sHitboxCacheEnd[OBJ_LIST_PUSHABLE]; a++) {
+        check_collision_in_cache(a, (a + 1), sHitboxCacheEnd[OBJ_LIST_PUSHABLE]);
+    }
+}
+#else
 void detect_object_collisions(void) {
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_POLELIKE]);
     clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_PLAYER]);
@@ -174,3 +293,4 @@ void detect_object_collisions(void) {
     check_destructive_object_collision();
     check_pushable_object_collision();
 }
+#endif
@@ -7,6 +7,7 @@
 #include "camera.h"
 #include "debug.h"
 #include "dialog_ids.h"
+#include "effect_pool.h"
 #include "engine/behavior_script.h"
 #include "engine/geo_layout.h"
 #include "engine/math_util.h"
@@ -97,6 +98,31 @@ Gfx *geo_update_layer_transparency(s32 callContext, struct GraphNode *node, UNUS
     return dlStart;
 }
 
+#ifdef TRANSPARENT_OBJECT_BATCHING
+/**
+ * Same as geo_update_layer_transparency with GEO_TRANSPARENCY_MODE_NORMAL, but the current object
+ * is drawn as an instance of the given display list batch instead of by the node's children.
+ */
+void geo_append_transparent_batch_instance(const struct DisplayListBatch *batch) {
+    struct Object *objectGraphNode = gCurGraphNodeObjectNode;
+
+    if (gCurGraphNodeHeldObject != NULL) {
+        objectGraphNode = gCurGraphNodeHeldObject->objNode;
+    }
+
+    s32 objectOpacity = objectGraphNode->oOpacity;
+
+    if (objectOpacity == 0xFF) {
+        objectGraphNode->oAnimState = TRANSPARENCY_ANIM_STATE_OPAQUE;
+        geo_append_display_list_batch_instance(batch, LAYER_OPAQUE, objectOpacity, FALSE);
+    } else {
+        objectGraphNode->oAnimState = TRANSPARENCY_ANIM_STATE_TRANSPARENT;
+        geo_append_display_list_batch_instance(batch, LAYER_TRANSPARENT, objectOpacity,
+                                               ((objectGraphNode->activeFlags & ACTIVE_FLAG_DITHERED_ALPHA) != 0));
+    }
+}
+#endif
+
 Gfx *geo_switch_anim_state(s32 callContext, struct GraphNode *node, UNUSED void *context) {
     if (callContext == GEO_CONTEXT_RENDER) {
         struct Object *obj = gCurGraphNodeObjectNode;
@@ -395,7 +421,7 @@ struct Object *spawn_object_at_origin(struct Object *parent, UNUSED s32 unusedAr
     obj->header.gfx.areaIndex = parent->header.gfx.areaIndex;
     obj->header.gfx.activeAreaIndex = parent->header.gfx.areaIndex;
 
-    geo_obj_init((struct GraphNodeObject *) &obj->header.gfx, gLoadedGraphNodes[model], gVec3fZero, gVec3sZero);
+    geo_obj_init((struct GraphNodeObject *) &obj->header.gfx, get_loaded_graph_node(model), gVec3fZero, gVec3sZero);
 
     return obj;
 }
@@ -851,26 +877,26 @@ void cur_obj_get_dropped(void) {
 }
 
 void obj_set_model(struct Object *obj, ModelID16 modelID) {
-    obj->header.gfx.sharedChild = gLoadedGraphNodes[modelID];
+    obj->header.gfx.sharedChild = get_loaded_graph_node(modelID);
 }
 
 void cur_obj_set_model(ModelID16 modelID) {
-    o->header.gfx.sharedChild = gLoadedGraphNodes[modelID];
+    o->header.gfx.sharedChild = get_loaded_graph_node(modelID);
 }
 
 s32 obj_has_model(struct Object *obj, ModelID16 modelID) {
-    return (obj->header.gfx.sharedChild == gLoadedGraphNodes[modelID]);
+    return model_uses_graph_node(modelID, obj->header.gfx.sharedChild);
 }
 
 s32 cur_obj_has_model(ModelID16 modelID) {
-    return (o->header.gfx.sharedChild == gLoadedGraphNodes[modelID]);
+    return model_uses_graph_node(modelID, o->header.gfx.sharedChild);
 }
 
 // HackerSM64 function
 ModelID32 obj_get_model_id(struct Object *obj) {
     if (!obj->header.gfx.sharedChild) {
         for (s32 i = MODEL_NONE; i < MODEL_ID_COUNT; i++) {
-            if (obj->header.gfx.sharedChild == gLoadedGraphNodes[i]) {
+            if (model_uses_graph_node(i, obj->header.gfx.sharedChild)) {
                 return i;
             }
         }
@@ -936,7 +962,7 @@ struct Surface *cur_obj_update_floor_height_and_get_floor(void) {
     return floor;
 }
 
-static void apply_drag_to_value(f32 *value, f32 dragStrength) {
+void apply_drag_to_value(f32 *value, f32 dragStrength) {
     f32 decel;
 
     if (*value != 0) {
@@ -1367,7 +1393,7 @@ s32 cur_obj_resolve_wall_collisions(void) {
         collisionData.x = (s16) o->oPosX;
         collisionData.y = (s16) o->oPosY;
         collisionData.z = (s16) o->oPosZ;
-        s32 numCollisions = find_wall_collisions(&collisionData);
+        s32 numCollisions = find_wall_collisions_with_clearance(&collisionData, &o->wallClearance);
         if (numCollisions != 0) {
             o->oPosX = collisionData.x;
             o->oPosY = collisionData.y;
@@ -1633,6 +1659,72 @@ void chain_segment_init(struct ChainSegment *segment) {
     vec3_zero(segment->angle);
 }
 
+/**
+ * Solve a hanging chain whose segment positions are relative to an origin, such as chain chomp's pivot.
+ * Segment 0 is the end being pulled, and each following segment falls by gravity, without going below the origin,
+ * and is then kept within maxDistBetween of the previous segment and within
+ * maxDistFromOriginPerSegment * (numSegments - i) of the origin.
+ */
+void chain_segments_apply_tether(struct ChainSegment *segments, s32 numSegments, f32 gravity,
+                                 f32 maxDistBetween, f32 maxDistFromOriginPerSegment) {
+    struct ChainSegment *prevSegment = &segments[0];
+    struct ChainSegment *segment = &segments[1];
+    Vec3f offset;
+    s32 i;
+
+    for (i = 1; i < numSegments; i++, prevSegment++, segment++) {
+        segment->pos[1] += gravity;
+        if (segment->pos[1] < 0.0f) {
+            segment->pos[1] = 0.0f;
+        }
+
+        // Cap distance to the previous segment, so that the chain follows the end being pulled.
+        vec3f_diff(offset, segment->pos, prevSegment->pos);
+        vec3_normalize_max(offset, maxDistBetween);
+
+        // Cap distance to the origin, so that the chain stretches when pulled far from it.
+        vec3f_add(offset, prevSegment->pos);
+        vec3_normalize_max(offset, (maxDistFromOriginPerSegment * (numSegments - i)));
+
+        vec3f_copy(segment->pos, offset);
+    }
+}
+
+/**
+ * Solve a body whose segments trail behind segment 0, such as wiggler's tail. Segment positions are global.
+ * Each segment turns and tilts toward the previous one by at most maxAngleDiff, and is then placed exactly
+ * segmentLength behind it along its own angle.
+ */
+void chain_segments_apply_follow(struct ChainSegment *segments, s32 numSegments, f32 segmentLength, s16 maxAngleDiff) {
+    struct ChainSegment *prevSegment = &segments[0];
+    struct ChainSegment *segment = &segments[1];
+    Vec3f d;
+    s16 dpitch, dyaw;
+    f32 dxz;
+    s32 i;
+
+    for (i = 1; i < numSegments; i++, prevSegment++, segment++) {
+        vec3_diff(d, segment->pos, prevSegment->pos);
+
+        // As the previous segment turns, propagate this rotation backward if the difference is more than maxAngleDiff.
+        dyaw = atan2s(-d[2], -d[0]) - prevSegment->angle[1];
+        dyaw = CLAMP(dyaw, -maxAngleDiff, maxAngleDiff);
+        segment->angle[1] = prevSegment->angle[1] + dyaw;
+
+        // As the previous segment tilts, propagate the tilt backward.
+        dxz = sqrtf(sqr(d[0]) + sqr(d[2]));
+        dpitch = atan2s(dxz, d[1]) - prevSegment->angle[0];
+        dpitch = CLAMP(dpitch, -maxAngleDiff, maxAngleDiff);
+        segment->angle[0] = prevSegment->angle[0] + dpitch;
+
+        // Place the segment relative to the previous one, using its own angles.
+        segment->pos[1] = segmentLength * sins(segment->angle[0]) + prevSegment->pos[1];
+        dxz = segmentLength * coss(segment->angle[0]);
+        segment->pos[0] = prevSegment->pos[0] - dxz * sins(segment->angle[1]);
+        segment->pos[2] = prevSegment->pos[2] - dxz * coss(segment->angle[1]);
+    }
+}
+
 f32 random_f32_around_zero(f32 diameter) {
     return random_float() * diameter - diameter / 2;
 }
@@ -1689,6 +1781,27 @@ void cur_obj_spawn_particles(struct SpawnParticlesInfo *info) {
     for (i = 0; i < numParticles; i++) {
         scale = random_float() * (info->sizeRange * 0.1f) + info->sizeBase * 0.1f;
 
+#ifdef EFFECT_POOL
+        // Particles that don't fade out can be spawned as effects instead of objects.
+        if (info->behParam < 2) {
+            struct Effect *effect = spawn_effect_with_model(o, info->model, effect_white_puff_update);
+
+            if (effect != NULL) {
+                s16 yaw = random_u16();
+                f32 forwardVel = random_float() * info->forwardVelRange + info->forwardVelBase;
+
+                effect->pos[1] += info->offsetY;
+                effect->vel[0] = forwardVel * sins(yaw);
+                effect->vel[1] = random_float() * info->velYRange + info->velYBase;
+                effect->vel[2] = forwardVel * coss(yaw);
+                effect->gravity = info->gravity;
+                effect->dragStrength = info->dragStrength;
+                effect->scale = scale;
+                continue;
+            }
+        }
+#endif
+
         particle = spawn_object(o, info->model, bhvWhitePuffExplosion);
 
         particle->oBehParams2ndByte = info->behParam;
@@ -1880,17 +1993,23 @@ s32 is_item_in_array(s8 item, s8 *array) {
     return FALSE;
 }
 
-void bhv_init_room(void) {
+/**
+ * Return the room of the floor below the given position, or -1 if the level doesn't use rooms.
+ */
+s32 get_room_at_pos(f32 x, f32 y, f32 z) {
     struct Surface *floor = NULL;
     if (is_item_in_array(gCurrLevelNum, sLevelsWithRooms)) {
-        find_room_floor(o->oPosX, o->oPosY, o->oPosZ, &floor);
+        find_room_floor(x, y, z, &floor);
 
         if (floor != NULL) {
-            o->oRoom = floor->room;
-            return;
+            return floor->room;
         }
     }
-    o->oRoom = -1;
+    return -1;
+}
+
+void bhv_init_room(void) {
+    o->oRoom = get_room_at_pos(o->oPosX, o->oPosY, o->oPosZ);
 }
 
 void cur_obj_enable_rendering_if_mario_in_room(void) {
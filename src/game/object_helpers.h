@@ -61,6 +61,10 @@ enum GeoUpdateLayerTransparencyModes {
 
 Gfx *geo_update_projectile_pos_from_parent(s32 callContext, UNUSED struct GraphNode *node, Mat4 mtx);
 Gfx *geo_update_layer_transparency(s32 callContext, struct GraphNode *node, UNUSED void *context);
+#ifdef TRANSPARENT_OBJECT_BATCHING
+struct DisplayListBatch;
+void geo_append_transparent_batch_instance(const struct DisplayListBatch *batch);
+#endif
 Gfx *geo_switch_anim_state(s32 callContext, struct GraphNode *node, UNUSED void *context);
 Gfx *geo_switch_area(s32 callContext, struct GraphNode *node, UNUSED void *context);
 void obj_update_pos_from_parent_transformation(Mat4 mtx, struct Object *obj);
@@ -193,11 +197,15 @@ s32 cur_obj_follow_path_new(void);
 // define is for backwards compatibility (arg used to be useless)
 #define cur_obj_follow_path(...) cur_obj_follow_path_new()
 void chain_segment_init(struct ChainSegment *segment);
+void chain_segments_apply_tether(struct ChainSegment *segments, s32 numSegments, f32 gravity,
+                                 f32 maxDistBetween, f32 maxDistFromOriginPerSegment);
+void chain_segments_apply_follow(struct ChainSegment *segments, s32 numSegments, f32 segmentLength, s16 maxAngleDiff);
 f32 random_f32_around_zero(f32 diameter);
 void obj_scale_random(struct Object *obj, f32 rangeLength, f32 minScale);
 void obj_translate_xyz_random(struct Object *obj, f32 rangeLength);
 void obj_translate_xz_random(struct Object *obj, f32 rangeLength);
 void cur_obj_set_pos_via_transform(void);
+void apply_drag_to_value(f32 *value, f32 dragStrength);
 void cur_obj_spawn_particles(struct SpawnParticlesInfo *info);
 s32 cur_obj_reflect_move_angle_off_wall(void);
 
@@ -235,6 +243,7 @@ void cur_obj_call_action_function(ObjActionFunc actionFunctions[]);
 s32 cur_obj_mario_far_away(void);
 s32 is_mario_moving_fast_or_in_air(s32 speedThreshold);
 s32 is_item_in_array(s8 item, s8 *array);
+s32 get_room_at_pos(f32 x, f32 y, f32 z);
 void cur_obj_enable_rendering_if_mario_in_room(void);
 s32 cur_obj_set_hitbox_and_die_if_attacked(struct ObjectHitbox *hitbox, s32 deathSound, s32 noLootCoins);
 void obj_explode_and_spawn_coins(f32 mistSize, s32 coinType);
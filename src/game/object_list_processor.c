@@ -4,7 +4,9 @@
 #include "area.h"
 #include "behavior_data.h"
 #include "camera.h"
+#include "coin_manager.h"
 #include "debug.h"
+#include "effect_pool.h"
 #include "engine/behavior_script.h"
 #include "engine/graph_node.h"
 #include "engine/surface_collision.h"
@@ -16,6 +18,7 @@
 #include "memory.h"
 #include "object_collision.h"
 #include "object_helpers.h"
+#include "path_cache.h"
 #include "object_list_processor.h"
 #include "platform_displacement.h"
 #include "spawn_object.h"
@@ -352,6 +355,192 @@ s32 update_objects_during_time_stop(struct ObjectNode *objList, struct ObjectNod
     return count;
 }
 
+#ifdef OBJECT_UPDATE_BATCHING
+/**
+ * Objects in a list are updated in groups that share a behavior script, so that the
+ * same behavior code and data are used several times in a row instead of being evicted
+ * from the caches by the other behaviors in between. Groups are updated in the order
+ * their behavior first appears in the list, and objects keep their list order within
+ * a group. A child is never put in a group that is updated before its parent's group.
+ */
+static struct Object *sListObjects[OBJECT_POOL_CAPACITY];
+static struct Object *sBatchedObjects[OBJECT_POOL_CAPACITY];
+static u16 sListObjectGroups[OBJECT_POOL_CAPACITY];
+static const BehaviorScript *sBatchGroupBehaviors[OBJECT_POOL_CAPACITY];
+static s16 sBatchGroupStarts[OBJECT_POOL_CAPACITY + 1];
+
+// The group of each object in the pool plus one while its list is being updated, 0 otherwise.
+// There can be as many groups as objects, so these are wide enough for any pool capacity.
+static u16 sObjectBatchGroups[OBJECT_POOL_CAPACITY];
+#define OBJECT_BATCH_UPDATED 0xFFFF
+
+#ifdef OBJECT_UPDATE_BATCHING_DEBUG
+// The number of times an object was changed by another object that was reordered around it.
+s32 gNumObjectUpdateOrderWarnings = 0;
+
+static u32 sListObjectChecksums[OBJECT_POOL_CAPACITY];
+static s16 sBatchedObjectListIndices[OBJECT_POOL_CAPACITY];
+
+static u32 object_checksum(struct Object *obj) {
+    u32 checksum = 0;
+    s32 i;
+
+    for (i = 0; i < MAX_OBJECT_FIELDS; i++) {
+        checksum = ((checksum << 5) | (checksum >> 27)) ^ obj->rawData.asU32[i];
+    }
+
+    return checksum;
+}
+
+static void warn_object_update_order(struct Object *obj) {
+    gNumObjectUpdateOrderWarnings++;
+#if PUPPYPRINT_DEBUG
+    append_puppyprint_log("Update order changed object %08X", (u32) obj->behavior);
+#endif
+}
+#endif
+
+/**
+ * Remove an object from the batch that is being updated. Called when an object
+ * is unloaded, so that its slot isn't updated again if it is reused this frame.
+ */
+void unschedule_batched_object_update(struct Object *obj) {
+    sObjectBatchGroups[obj - gObjectPool] = 0;
+}
+
+static s32 get_object_batch_group(struct Object *obj) {
+    // Macro objects use gMacroObjectDefaultParent as their parent, which isn't in the pool.
+    if (obj < gObjectPool || obj >= &gObjectPool[OBJECT_POOL_CAPACITY]) {
+        return 0;
+    }
+
+    return sObjectBatchGroups[obj - gObjectPool];
+}
+
+/**
+ * Update every object in the list grouped by behavior, then any objects that were
+ * spawned into the list during the update in list order, like update_objects_starting_at.
+ * Return the number of objects that were updated.
+ */
+static s32 update_objects_in_list_batched(struct ObjectNode *objList) {
+    struct ObjectNode *node;
+    struct Object *obj;
+    s32 numObjects = 0;
+    s32 numGroups = 0;
+    s32 group, i;
+
+    // Assign every object to a group.
+    for (node = objList->next; node != objList; node = node->next) {
+        obj = (struct Object *) node;
+        group = 0;
+
+        if (obj->parentObj != NULL && obj->parentObj != obj) {
+            s32 parentGroup = get_object_batch_group(obj->parentObj);
+            if (parentGroup != 0) {
+                group = (parentGroup - 1);
+            }
+        }
+
+        while (group < numGroups && sBatchGroupBehaviors[group] != obj->behavior) {
+            group++;
+        }
+
+        if (group == numGroups) {
+            sBatchGroupBehaviors[numGroups] = obj->behavior;
+            sBatchGroupStarts[numGroups + 1] = 0;
+            numGroups++;
+        }
+
+        sBatchGroupStarts[group + 1]++;
+        sObjectBatchGroups[obj - gObjectPool] = (group + 1);
+        sListObjectGroups[numObjects] = group;
+        sListObjects[numObjects++] = obj;
+    }
+
+    // Sort the objects by group, keeping their list order within each group.
+    sBatchGroupStarts[0] = 0;
+    for (group = 0; group < numGroups; group++) {
+        sBatchGroupStarts[group + 1] += sBatchGroupStarts[group];
+    }
+
+    for (i = 0; i < numObjects; i++) {
+        s32 batchIndex = sBatchGroupStarts[sListObjectGroups[i]]++;
+        sBatchedObjects[batchIndex] = sListObjects[i];
+#ifdef OBJECT_UPDATE_BATCHING_DEBUG
+        sBatchedObjectListIndices[batchIndex] = i;
+        sListObjectChecksums[i] = object_checksum(sListObjects[i]);
+#endif
+    }
+
+#ifdef OBJECT_UPDATE_BATCHING_DEBUG
+    s32 maxListIndexUpdated = -1;
+#endif
+
+    for (i = 0; i < numObjects; i++) {
+        obj = sBatchedObjects[i];
+
+        // Skip objects that were unloaded by another object this frame.
+        if (sObjectBatchGroups[obj - gObjectPool] == 0) {
+            continue;
+        }
+        sObjectBatchGroups[obj - gObjectPool] = OBJECT_BATCH_UPDATED;
+
+#ifdef OBJECT_UPDATE_BATCHING_DEBUG
+        // If something changed the object before its update, and an object that comes
+        // after it in the list was already updated, the change may not have happened yet
+        // in list order.
+        s32 listIndex = sBatchedObjectListIndices[i];
+        if (maxListIndexUpdated > listIndex && object_checksum(obj) != sListObjectChecksums[listIndex]) {
+            warn_object_update_order(obj);
+        }
+        maxListIndexUpdated = MAX(maxListIndexUpdated, listIndex);
+#endif
+
+        gCurrentObject = obj;
+        gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
+        cur_obj_update();
+
+#ifdef OBJECT_UPDATE_BATCHING_DEBUG
+        sListObjectChecksums[listIndex] = object_checksum(obj);
+#endif
+    }
+
+#ifdef OBJECT_UPDATE_BATCHING_DEBUG
+    // If something changed an object after its update, and the object that did it comes
+    // before it in the list, the change would have been seen by its update in list order.
+    s32 minListIndexUpdatedAfter = numObjects;
+    for (i = (numObjects - 1); i >= 0; i--) {
+        s32 listIndex = sBatchedObjectListIndices[i];
+        obj = sBatchedObjects[i];
+
+        if (minListIndexUpdatedAfter < listIndex && sObjectBatchGroups[obj - gObjectPool] == OBJECT_BATCH_UPDATED
+            && object_checksum(obj) != sListObjectChecksums[listIndex]) {
+            warn_object_update_order(obj);
+        }
+        minListIndexUpdatedAfter = MIN(minListIndexUpdatedAfter, listIndex);
+    }
+#endif
+
+    // Objects spawned during the update were added to the end of the list, and
+    // may have taken the slot of an object that was unloaded.
+    for (node = objList->next; node != objList; node = node->next) {
+        obj = (struct Object *) node;
+
+        if (sObjectBatchGroups[obj - gObjectPool] == OBJECT_BATCH_UPDATED) {
+            sObjectBatchGroups[obj - gObjectPool] = 0;
+            continue;
+        }
+
+        gCurrentObject = obj;
+        gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
+        cur_obj_update();
+        numObjects++;
+    }
+
+    return numObjects;
+}
+#endif
+
 /**
  * Update every object in the given list. Return the total number of objects in
  * the list.
@@ -361,7 +550,11 @@ s32 update_objects_in_list(struct ObjectNode *objList) {
     struct ObjectNode *firstObj = objList->next;
 
     if (!(gTimeStopState & TIME_STOP_ACTIVE)) {
+#ifdef OBJECT_UPDATE_BATCHING
+        count = update_objects_in_list_batched(objList);
+#else
         count = update_objects_starting_at(objList, firstObj);
+#endif
     } else {
         count = update_objects_during_time_stop(objList, firstObj);
     }
@@ -406,17 +599,24 @@ s32 unload_deactivated_objects_in_list(struct ObjectNode *objList) {
  * SpawnInfo.
  */
 void set_object_respawn_info_bits(struct Object *obj, u8 bits) {
+    set_respawn_info_bits(obj->respawnInfo, obj->respawnInfoType, bits);
+}
+
+/**
+ * Same as set_object_respawn_info_bits, for spawn info that is no longer tied to an object.
+ */
+void set_respawn_info_bits(void *respawnInfo, s32 respawnInfoType, u8 bits) {
     u32 *info32;
     u16 *info16;
 
-    switch (obj->respawnInfoType) {
+    switch (respawnInfoType) {
         case RESPAWN_INFO_TYPE_NORMAL:
-            info32 = (u32 *) obj->respawnInfo;
+            info32 = (u32 *) respawnInfo;
             *info32 |= bits << 8;
             break;
 
         case RESPAWN_INFO_TYPE_MACRO_OBJECT:
-            info16 = (u16 *) obj->respawnInfo;
+            info16 = (u16 *) respawnInfo;
             *info16 |= bits << 8;
             break;
     }
@@ -445,6 +645,13 @@ void unload_objects_from_area(UNUSED s32 unused, s32 areaIndex) {
             }
         }
     }
+
+#ifdef COIN_MANAGER
+    coin_manager_unload_area(areaIndex);
+#endif
+#ifdef EFFECT_POOL
+    effect_pool_unload_area(areaIndex);
+#endif
 }
 
 /**
@@ -540,6 +747,15 @@ void clear_objects(void) {
     gObjectLists = gObjectListArray;
 
     clear_dynamic_surfaces();
+#ifdef COIN_MANAGER
+    coin_manager_clear();
+#endif
+#ifdef EFFECT_POOL
+    effect_pool_clear();
+#endif
+#ifdef PATH_CACHE
+    path_cache_clear();
+#endif
 }
 
 /**
@@ -647,6 +863,11 @@ void update_objects(UNUSED s32 unused) {
     // cycleCounts[4] = get_clock_difference(cycleCounts[0]);
     update_non_terrain_objects();
 
+#ifdef EFFECT_POOL
+    // Update lightweight effects such as sparkles and dust
+    update_effects();
+#endif
+
     // Unload any objects that have been deactivated
     // cycleCounts[5] = get_clock_difference(cycleCounts[0]);
     unload_deactivated_objects();
@@ -125,10 +125,17 @@ extern s16 gMarioOnMerryGoRound;
 
 void bhv_mario_update(void);
 void set_object_respawn_info_bits(struct Object *obj, u8 bits);
+void set_respawn_info_bits(void *respawnInfo, s32 respawnInfoType, u8 bits);
 void unload_objects_from_area(UNUSED s32 unused, s32 areaIndex);
 void spawn_objects_from_info(UNUSED s32 unused, struct SpawnInfo *spawnInfo);
 void clear_objects(void);
 void update_objects(UNUSED s32 unused);
+#ifdef OBJECT_UPDATE_BATCHING
+void unschedule_batched_object_update(struct Object *obj);
+#endif
+#ifdef OBJECT_UPDATE_BATCHING_DEBUG
+extern s32 gNumObjectUpdateOrderWarnings;
+#endif
 
 
 #endif // OBJECT_LIST_PROCESSOR_H
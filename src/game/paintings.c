@@ -18,6 +18,7 @@
 #include "paintings.h"
 #include "save_file.h"
 #include "segment2.h"
+#include "rendering_graph_node.h"
 
 /**
  * @file paintings.c
@@ -1046,6 +1047,28 @@ Gfx *display_painting_not_rippling(struct Painting *painting) {
     return dlist;
 }
 
+#ifdef GEO_MEMOIZATION
+/**
+ * Same as display_painting_not_rippling, but the list and its matrices are kept
+ * for as long as the painting doesn't move.
+ */
+Gfx *display_painting_not_rippling_cached(struct GraphNode *node, struct Painting *painting) {
+    struct {
+        f32 transform[6];
+        const Gfx *displayList;
+    } key = {
+        { painting->pitch, painting->yaw, painting->posX, painting->posY, painting->posZ, painting->size },
+        painting->normalDisplayList,
+    };
+    Gfx *dlist = geo_memo_begin(node, 0, &key, sizeof(key), ((4 * sizeof(Mtx)) + (9 * sizeof(Gfx))), NULL);
+
+    if (dlist != NULL) {
+        return dlist;
+    }
+    return geo_memo_end(display_painting_not_rippling(painting), NULL);
+}
+#endif
+
 /**
  * Clear Mario-related state and clear gRipplingPainting.
  */
@@ -1236,7 +1259,15 @@ Gfx *geo_painting_draw(s32 callContext, struct GraphNode *node, UNUSED void *con
         set_painting_layer(gen, painting);
 
         // Draw before updating
+#ifdef GEO_MEMOIZATION
+        if (painting->state == PAINTING_IDLE) {
+            paintingDlist = display_painting_not_rippling_cached(node, painting);
+        } else {
+            paintingDlist = display_painting(painting);
+        }
+#else
         paintingDlist = display_painting(painting);
+#endif
 
         // Update the painting
         painting_update_floors(painting);
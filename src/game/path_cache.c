@@ -0,0 +1,134 @@
+#include <PR/ultratypes.h>
+
+#include "sm64.h"
+#include "engine/math_util.h"
+#include "object_helpers.h"
+#include "path_cache.h"
+
+/**
+ * The path cache stores the cumulative arc length and direction of every
+ * segment of a path, computed once the first time the path is followed.
+ * This lets an object keep track of how far along a path it is, and find its
+ * position and heading at any distance without walking the waypoints and
+ * measuring each segment again every frame.
+ */
+
+#ifdef PATH_CACHE
+
+static struct PathCache   sPathCaches[PATH_CACHE_MAX_PATHS];
+static struct PathSegment sPathSegments[PATH_CACHE_MAX_SEGMENTS];
+static s32 sNumPathCaches = 0;
+static s32 sNumPathSegments = 0;
+
+/**
+ * Reset the cache. Called whenever the object pool is cleared, since the
+ * paths belong to the level that was loaded.
+ */
+void path_cache_clear(void) {
+    sNumPathCaches = 0;
+    sNumPathSegments = 0;
+}
+
+/**
+ * Return the cached path starting at the given waypoint, caching it if necessary.
+ * Returns NULL if the cache is full.
+ */
+struct PathCache *path_cache_get(const struct Waypoint *waypoints) {
+    struct PathCache *path = sPathCaches;
+    s32 numWaypoints = 0;
+    s32 i;
+
+    for (i = 0; i < sNumPathCaches; i++, path++) {
+        if (path->waypoints == waypoints) {
+            return path;
+        }
+    }
+
+    while (waypoints[numWaypoints].flags != WAYPOINT_FLAGS_END) {
+        numWaypoints++;
+    }
+
+    if (numWaypoints == 0 || sNumPathCaches >= PATH_CACHE_MAX_PATHS
+        || sNumPathSegments + numWaypoints > PATH_CACHE_MAX_SEGMENTS) {
+        return NULL;
+    }
+
+    path->waypoints = waypoints;
+    path->segments = &sPathSegments[sNumPathSegments];
+    path->numWaypoints = numWaypoints;
+
+    struct PathSegment *segment = path->segments;
+    const struct Waypoint *next;
+    Vec3f d;
+    f32 dist = 0.0f;
+    f32 segmentLength;
+
+    for (i = 0; i < numWaypoints; i++, segment++) {
+        next = (i + 1 < numWaypoints) ? &waypoints[i + 1] : &waypoints[0];
+        if (i + 1 == numWaypoints) {
+            path->length = dist;
+        }
+
+        vec3_diff(d, next->pos, waypoints[i].pos);
+        segmentLength = vec3_mag(d);
+
+        segment->startDist = dist;
+        segment->yaw = atan2s(d[2], d[0]);
+        segment->pitch = atan2s(sqrtf(sqr(d[0]) + sqr(d[2])), -d[1]);
+        if (segmentLength > 0.0f) {
+            vec3_quot_val(segment->dir, d, segmentLength);
+        } else {
+            vec3_zero(segment->dir);
+        }
+
+        dist += segmentLength;
+    }
+
+    path->loopLength = dist;
+
+    // A path that doesn't go anywhere can't be followed by distance.
+    if (path->loopLength <= 0.0f) {
+        return NULL;
+    }
+
+    sNumPathSegments += numWaypoints;
+    sNumPathCaches++;
+
+    return path;
+}
+
+/**
+ * Return the segment that the given distance along the path lies on.
+ * segmentHint is where to start searching from, usually the segment the
+ * object was on last frame, which makes the search constant time.
+ * A distance exactly at a waypoint counts as the end of the previous segment.
+ */
+s32 path_cache_find_segment(const struct PathCache *path, f32 dist, s32 segmentHint) {
+    const struct PathSegment *segments = path->segments;
+    s32 segment = segmentHint;
+
+    if (segment < 0 || segment >= path->numWaypoints || dist <= segments[segment].startDist) {
+        segment = 0;
+    }
+
+    while (segment + 1 < path->numWaypoints && segments[segment + 1].startDist < dist) {
+        segment++;
+    }
+
+    return segment;
+}
+
+/**
+ * Compute the position at the given distance along the path, which lies on the given segment.
+ */
+void path_cache_get_pos(const struct PathCache *path, f32 dist, s32 segment, Vec3f pos) {
+    const struct PathSegment *pathSegment = &path->segments[segment];
+    f32 distAlongSegment = dist - pathSegment->startDist;
+
+    vec3s_to_vec3f(pos, path->waypoints[segment].pos);
+    pos[0] += pathSegment->dir[0] * distAlongSegment;
+    pos[1] += pathSegment->dir[1] * distAlongSegment;
+    pos[2] += pathSegment->dir[2] * distAlongSegment;
+}
+
+#endif // PATH_CACHE
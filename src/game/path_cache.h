@@ -0,0 +1,39 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+#ifdef PATH_CACHE
+
+// The maximum number of paths that can be cached at once.
+#define PATH_CACHE_MAX_PATHS 16
+// The maximum number of segments shared by all cached paths.
+// Any paths past either limit are followed by walking their waypoints instead.
+#define PATH_CACHE_MAX_SEGMENTS 256
+
+struct PathSegment {
+    /*0x00*/ f32 startDist; // Distance along the path from the first waypoint to the start of this segment.
+    /*0x04*/ Vec3f dir;     // Unit direction from the start of this segment to its end.
+    /*0x10*/ s16 yaw;       // Heading along this segment, the same as atan2 of a velocity along it.
+    /*0x12*/ s16 pitch;
+}; /*0x14*/
+
+struct PathCache {
+    /*0x00*/ const struct Waypoint *waypoints;
+    // One segment per waypoint. The last segment goes from the last waypoint back to the first one.
+    /*0x04*/ struct PathSegment *segments;
+    /*0x08*/ f32 length;     // Distance from the first waypoint to the last one.
+    /*0x0C*/ f32 loopLength; // Distance from the first waypoint back to itself through every other waypoint.
+    /*0x10*/ s32 numWaypoints;
+}; /*0x14*/
+
+void path_cache_clear(void);
+struct PathCache *path_cache_get(const struct Waypoint *waypoints);
+s32  path_cache_find_segment(const struct PathCache *path, f32 dist, s32 segmentHint);
+void path_cache_get_pos(const struct PathCache *path, f32 dist, s32 segment, Vec3f pos);
+
+#endif // PATH_CACHE
+
+#endif // PATH_CACHE_H
@@ -412,6 +412,47 @@ void render_textrect(s32 x, s32 y, s32 pos) {
                         (rectY + 15) << 2, G_TX_RENDERTILE, 0, 0, 4 << 10, 1 << 10);
 }
 
+/**
+ * Renders the glyph for a character of a text label.
+ */
+static void render_text_glyph(s32 x, s32 y, s32 pos, char c) {
+    s8 glyphIndex = char_to_glyph_index(c);
+
+    if (glyphIndex != GLYPH_SPACE) {
+#ifdef VERSION_EU
+        // Beta Key was removed by EU, so glyph slot reused.
+        // This produces a colorful Ü.
+        if (glyphIndex == GLYPH_BETA_KEY) {
+            add_glyph_texture(GLYPH_U);
+            render_textrect(x, y, pos);
+
+            add_glyph_texture(GLYPH_UMLAUT);
+            render_textrect(x, y + 3, pos);
+        } else {
+            add_glyph_texture(glyphIndex);
+            render_textrect(x, y, pos);
+        }
+#else
+        add_glyph_texture(glyphIndex);
+        render_textrect(x, y, pos);
+#endif
+    }
+}
+
+#ifdef RETAINED_HUD
+/**
+ * Renders text in the colorful lettering right away instead of adding a text label,
+ * for display lists that are kept between frames. dl_hud_img_begin must be called first.
+ */
+void render_text_glyphs(s32 x, s32 y, const char *str) {
+    s32 pos;
+
+    for (pos = 0; str[pos] != '\0'; pos++) {
+        render_text_glyph(x, y, pos, str[pos]);
+    }
+}
+#endif
+
 /**
  * Renders the text in sTextLabels on screen at the proper locations by iterating
  * a for loop.
@@ -419,7 +460,6 @@ void render_textrect(s32 x, s32 y, s32 pos) {
 void render_text_labels(void) {
     s32 i;
     s32 j;
-    s8 glyphIndex;
     Mtx *mtx;
 
     if (sTextLabelsCount == 0) {
@@ -440,27 +480,7 @@ void render_text_labels(void) {
 
     for (i = 0; i < sTextLabelsCount; i++) {
         for (j = 0; j < sTextLabels[i]->length; j++) {
-            glyphIndex = char_to_glyph_index(sTextLabels[i]->buffer[j]);
-
-            if (glyphIndex != GLYPH_SPACE) {
-#ifdef VERSION_EU
-                // Beta Key was removed by EU, so glyph slot reused.
-                // This produces a colorful Ü.
-                if (glyphIndex == GLYPH_BETA_KEY) {
-                    add_glyph_texture(GLYPH_U);
-                    render_textrect(sTextLabels[i]->x, sTextLabels[i]->y, j);
-
-                    add_glyph_texture(GLYPH_UMLAUT);
-                    render_textrect(sTextLabels[i]->x, sTextLabels[i]->y + 3, j);
-                } else {
-                    add_glyph_texture(glyphIndex);
-                    render_textrect(sTextLabels[i]->x, sTextLabels[i]->y, j);
-                }
-#else
-                add_glyph_texture(glyphIndex);
-                render_textrect(sTextLabels[i]->x, sTextLabels[i]->y, j);
-#endif
-            }
+            render_text_glyph(sTextLabels[i]->x, sTextLabels[i]->y, j, sTextLabels[i]->buffer[j]);
         }
 
         mem_pool_free(gEffectsMemoryPool, sTextLabels[i]);
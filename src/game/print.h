@@ -33,6 +33,9 @@ enum PrintfGlyphs {
 void print_text_fmt_int(s32 x, s32 y, const char *str, s32 n);
 void print_text(s32 x, s32 y, const char *str);
 void print_text_centered(s32 x, s32 y, const char *str);
+#ifdef RETAINED_HUD
+void render_text_glyphs(s32 x, s32 y, const char *str);
+#endif
 void render_text_labels(void);
 
 #endif // PRINT_H
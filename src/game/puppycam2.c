@@ -25,6 +25,7 @@
 #include "puppyprint.h"
 #include "debug_box.h"
 #include "main.h"
+#include "string.h"
 
 #ifdef PUPPYCAM
 
@@ -514,6 +515,9 @@ void puppycam_init(void) {
     gPuppyCam.mode3Flags            = PUPPYCAM_MODE3_ZOOMED_MED;
     gPuppyCam.debugFlags            = PUPPYDEBUG_LOCK_CONTROLS;
     puppycam_reset_values();
+#ifdef PUPPYCAM_COHERENT_COLLISION
+    puppycam_clear_collision_cache();
+#endif
 }
 
 void puppycam_input_pitch(void) {
@@ -1240,7 +1244,6 @@ static void puppycam_script(void) {
 
 // Handles collision detection using ray casting.
 static void puppycam_collision(void) {
-    struct WallCollisionData wall0, wall1;
     struct Surface *surf[2];
     Vec3f camdir[2];
     Vec3f hitpos[2];
@@ -1262,10 +1265,11 @@ static void puppycam_collision(void) {
 
     vec3_copy(camdir[1], camdir[0]);
 
-    find_surface_on_ray(target[0], camdir[0], &surf[0], hitpos[0], RAYCAST_FIND_FLOOR | RAYCAST_FIND_CEIL | RAYCAST_FIND_WALL);
-    find_surface_on_ray(target[1], camdir[1], &surf[1], hitpos[1], RAYCAST_FIND_FLOOR | RAYCAST_FIND_CEIL | RAYCAST_FIND_WALL);
-    resolve_and_return_wall_collisions(hitpos[0], 0.0f, 25.0f, &wall0);
-    resolve_and_return_wall_collisions(hitpos[1], 0.0f, 25.0f, &wall1);
+#ifdef PUPPYCAM_COHERENT_COLLISION
+    puppycam_cast_rays_coherent(target, camdir, surf, hitpos);
+#else
+    puppycam_cast_rays(target, camdir, surf, hitpos);
+#endif
     dist[0] = ((target[0][0] - hitpos[0][0]) * (target[0][0] - hitpos[0][0]) + (target[0][1] - hitpos[0][1]) * (target[0][1] - hitpos[0][1]) + (target[0][2] - hitpos[0][2]) * (target[0][2] - hitpos[0][2]));
     dist[1] = ((target[1][0] - hitpos[1][0]) * (target[1][0] - hitpos[1][0]) + (target[1][1] - hitpos[1][1]) * (target[1][1] - hitpos[1][1]) + (target[1][2] - hitpos[1][2]) * (target[1][2] - hitpos[1][2]));
 
@@ -176,12 +176,21 @@ enum gPuppyCamBeh
 extern const struct sPuppyAngles puppyAnglesNull;
 extern u8 gPCOptionOpen;
 extern s32 gPuppyError;
+#ifdef PUPPYCAM_COHERENT_COLLISION
+extern s32 gPuppyCamRaysCast;
+extern s32 gPuppyCamRaysReused;
+#endif
 extern struct gPuppyStruct gPuppyCam;
 extern struct sPuppyVolume *sPuppyVolumeStack[MAX_PUPPYCAM_VOLUMES];
 extern u16 gPuppyVolumeCount;
 extern struct MemoryPool *gPuppyMemoryPool;
 extern void puppycam_boot(void);
 extern void puppycam_init(void);
+extern void puppycam_cast_rays(Vec3f target[2], Vec3f camdir[2], struct Surface *surf[2], Vec3f hitpos[2]);
+#ifdef PUPPYCAM_COHERENT_COLLISION
+extern void puppycam_cast_rays_coherent(Vec3f target[2], Vec3f camdir[2], struct Surface *surf[2], Vec3f hitpos[2]);
+extern void puppycam_clear_collision_cache(void);
+#endif
 extern void puppycam_loop(void);
 extern void puppycam_shake(s16 x, s16 y, s16 z);
 extern f32 approach_f32_asymptotic(f32 current, f32 target, f32 multiplier);
@@ -0,0 +1,106 @@
+#include <PR/ultratypes.h>
+
+#include "sm64.h"
+#include "types.h"
+#include "area.h"
+#include "puppycam2.h"
+#include "engine/math_util.h"
+#include "engine/surface_collision.h"
+#include "engine/surface_load.h"
+#include "string.h"
+
+#ifdef PUPPYCAM
+// Casts the camera rays from the top and bottom of the target, then pushes the hit points out of walls.
+void puppycam_cast_rays(Vec3f target[2], Vec3f camdir[2], struct Surface *surf[2], Vec3f hitpos[2]) {
+    struct WallCollisionData wall0, wall1;
+
+    find_surface_on_ray(target[0], camdir[0], &surf[0], hitpos[0], RAYCAST_FIND_FLOOR | RAYCAST_FIND_CEIL | RAYCAST_FIND_WALL);
+    find_surface_on_ray(target[1], camdir[1], &surf[1], hitpos[1], RAYCAST_FIND_FLOOR | RAYCAST_FIND_CEIL | RAYCAST_FIND_WALL);
+    resolve_and_return_wall_collisions(hitpos[0], 0.0f, 25.0f, &wall0);
+    resolve_and_return_wall_collisions(hitpos[1], 0.0f, 25.0f, &wall1);
+}
+
+#ifdef PUPPYCAM_COHERENT_COLLISION
+s32 gPuppyCamRaysCast = 0;
+s32 gPuppyCamRaysReused = 0;
+
+// How far around the rays to look for object collision, which covers the hit points being pushed out of walls.
+#define PUPPYCAM_RAY_CACHE_MARGIN 100
+
+// The result of the last cast, reused while the rays are exactly the same and only level geometry is near them.
+static struct PuppyCamRayCache {
+    Vec3f target[2];
+    Vec3f camdir[2];
+    Vec3f hitpos[2];
+    struct Surface *surf[2];
+    struct Area *area;
+    u8 valid;
+} sPuppyCamRayCache;
+
+void puppycam_clear_collision_cache(void) {
+    sPuppyCamRayCache.valid = FALSE;
+    gPuppyCamRaysCast = 0;
+    gPuppyCamRaysReused = 0;
+}
+
+// Object collision is reloaded every frame, so the rays can only be reused when none of it is nearby.
+static s32 puppycam_rays_near_dynamic_surfaces(Vec3f target, Vec3f camdir) {
+    s32 minX = CLAMP(target[0] + MIN(camdir[0], 0) - PUPPYCAM_RAY_CACHE_MARGIN, -LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX - 1);
+    s32 maxX = CLAMP(target[0] + MAX(camdir[0], 0) + PUPPYCAM_RAY_CACHE_MARGIN, -LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX - 1);
+    s32 minZ = CLAMP(target[2] + MIN(camdir[2], 0) - PUPPYCAM_RAY_CACHE_MARGIN, -LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX - 1);
+    s32 maxZ = CLAMP(target[2] + MAX(camdir[2], 0) + PUPPYCAM_RAY_CACHE_MARGIN, -LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX - 1);
+    s32 minCellX = GET_CELL_COORD(minX);
+    s32 maxCellX = GET_CELL_COORD(maxX);
+    s32 minCellZ = GET_CELL_COORD(minZ);
+    s32 maxCellZ = GET_CELL_COORD(maxZ);
+    s32 cellX, cellZ;
+
+    for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+        for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+            if (gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next != NULL
+             || gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ].next != NULL
+             || gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ].next != NULL) {
+                return TRUE;
+            }
+        }
+    }
+
+    return FALSE;
+}
+
+// Reuses the last cast if the rays haven't changed, otherwise casts them again and keeps the result.
+void puppycam_cast_rays_coherent(Vec3f target[2], Vec3f camdir[2], struct Surface *surf[2], Vec3f hitpos[2]) {
+    struct PuppyCamRayCache *cache = &sPuppyCamRayCache;
+    // Both rays share their X and Z, so one box covers them.
+    s32 nearDynamic = puppycam_rays_near_dynamic_surfaces(target[0], camdir[0]);
+
+    if (cache->valid && !nearDynamic && cache->area == gCurrentArea
+        && memcmp(cache->target, target, sizeof(cache->target)) == 0
+        && memcmp(cache->camdir, camdir, sizeof(cache->camdir)) == 0) {
+        surf[0] = cache->surf[0];
+        surf[1] = cache->surf[1];
+        vec3f_copy(hitpos[0], cache->hitpos[0]);
+        vec3f_copy(hitpos[1], cache->hitpos[1]);
+        gPuppyCamRaysReused += 2;
+        return;
+    }
+
+    puppycam_cast_rays(target, camdir, surf, hitpos);
+    gPuppyCamRaysCast += 2;
+
+    // A result involving object collision can't be reused, since that may have moved by the next frame.
+    cache->valid = !nearDynamic;
+    if (cache->valid) {
+        memcpy(cache->target, target, sizeof(cache->target));
+        memcpy(cache->camdir, camdir, sizeof(cache->camdir));
+        vec3f_copy(cache->hitpos[0], hitpos[0]);
+        vec3f_copy(cache->hitpos[1], hitpos[1]);
+        cache->surf[0] = surf[0];
+        cache->surf[1] = surf[1];
+        cache->area = gCurrentArea;
+    }
+}
+#endif
+
+
+#endif
@@ -34,7 +34,11 @@ a modern game engine's developer's console.
 #include "printf.h"
 #include "engine/math_util.h"
 #include "engine/behavior_script.h"
+#include "engine/level_script.h"
 #include "camera.h"
+#include "coin_manager.h"
+#include "effect_pool.h"
+#include "puppycam2.h"
 #include "puppyprint.h"
 #include "level_update.h"
 #include "object_list_processor.h"
@@ -96,6 +100,10 @@ u32    rspGenTime[NUM_PERF_ITERATIONS + 1];
 u32    bufferTime[NUM_PERF_ITERATIONS + 1];
 u32      tmemTime[NUM_PERF_ITERATIONS + 1];
 u32       busTime[NUM_PERF_ITERATIONS + 1];
+#ifdef PUPPYPRINT_RDP_MARKERS
+u32  rdpSegmentBusyTime[RDP_SEGMENT_COUNT][NUM_PERF_ITERATIONS + 1];
+u32 rdpSegmentTotalTime[RDP_SEGMENT_COUNT][NUM_PERF_ITERATIONS + 1];
+#endif
 // RAM
 s8  ramViewer = FALSE;
 s32 ramsizeSegment[NUM_TLB_SEGMENTS + 1] = {
@@ -556,11 +564,25 @@ void puppyprint_render_standard(void) {
     u32 i;
     s32 viewedNums;
     char textBytes[80];
+    s32 textLength = 0;
 
     print_basic_profiling();
 
-    sprintf(textBytes, "OBJ: %d/%d", gObjectCounter, OBJECT_POOL_CAPACITY);
+    textLength += sprintf(&textBytes[textLength], "OBJ: %d/%d", gObjectCounter, OBJECT_POOL_CAPACITY);
+#ifdef COIN_MANAGER
+    textLength += sprintf(&textBytes[textLength], " COINS: %d/%d", gNumManagedCoins, COIN_MANAGER_CAPACITY);
+#endif
+#ifdef EFFECT_POOL
+    textLength += sprintf(&textBytes[textLength], " FX: %d/%d (%d)", gNumEffects, EFFECT_POOL_CAPACITY, gNumEffectsSpawned);
+#endif
+#if defined(PUPPYCAM) && defined(PUPPYCAM_COHERENT_COLLISION)
+    textLength += sprintf(&textBytes[textLength], " RAYS: %d/%d", gPuppyCamRaysCast, (gPuppyCamRaysCast + gPuppyCamRaysReused));
+#endif
     print_small_text(16, 124, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+#ifdef LAZY_MODEL_LOADING
+    sprintf(textBytes, "MODELS: %d %dKB %dus", gNumModelsBuilt, (gModelGraphsSize / 1024), (s32) OS_CYCLES_TO_USEC(gModelBuildTime));
+    print_small_text(16, 132, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+#endif
 
 #ifndef ENABLE_CREDITS_BENCHMARK
     // Very little point printing useless info if Mario doesn't even exist.
@@ -648,6 +670,65 @@ void puppyprint_render_minimal(void) {
     print_basic_profiling();
 }
 
+#ifdef PUPPYPRINT_RDP_MARKERS
+static const char *sRdpSegmentNames[RDP_SEGMENT_COUNT] = {
+    [RDP_SEGMENT_BACKGROUND] = "Background",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_FORCE] = "Force",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_OPAQUE] = "Opaque",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_OPAQUE_INTER] = "Opaque Inter",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_OPAQUE_DECAL] = "Opaque Decal",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_ALPHA] = "Alpha",
+#if SILHOUETTE
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_ALPHA_DECAL] = "Alpha Decal",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_SILHOUETTE_OPAQUE] = "Silhouette Opaque",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_SILHOUETTE_ALPHA] = "Silhouette Alpha",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_OCCLUDE_SILHOUETTE_OPAQUE] = "Occlude Opaque",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_OCCLUDE_SILHOUETTE_ALPHA] = "Occlude Alpha",
+#endif
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_TRANSPARENT_DECAL] = "Transparent Decal",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_TRANSPARENT] = "Transparent",
+    [RDP_SEGMENT_LAYER_FIRST + LAYER_TRANSPARENT_INTER] = "Transparent Inter",
+    [RDP_SEGMENT_OTHER] = "HUD and Other",
+};
+
+/**
+ * Busy is how long the RDP's pipeline was drawing during a segment, total is
+ * how long the segment took from start to end. When total is much larger than
+ * busy, the RDP was waiting for the RSP to send it commands.
+ * The markers only exist while this page is open, so comparing the RDP time
+ * here with the Minimal page shows what they cost.
+ */
+void puppyprint_render_rdp_layers(void) {
+    char textBytes[80];
+    s32 i;
+    s32 posY = 84;
+
+    print_basic_profiling();
+    print_small_text(16, posY, "Layer: busy / total", PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+    posY += 12;
+
+    for (i = 0; i < RDP_SEGMENT_COUNT; i++) {
+        u32 busy  =  rdpSegmentBusyTime[i][NUM_PERF_ITERATIONS];
+        u32 total = rdpSegmentTotalTime[i][NUM_PERF_ITERATIONS];
+
+        // Layers with nothing in them still get a marker, so only their total isn't 0.
+        if (busy == 0) {
+            continue;
+        }
+#if BBPLAYER == 1 // iQue RDP registers need to be halved to be correct.
+        busy /= 2;
+#endif
+#ifdef PUPPYPRINT_DEBUG_CYCLES
+        sprintf(textBytes, "%s: %dc / %dc", sRdpSegmentNames[i], busy, total);
+#else
+        sprintf(textBytes, "%s: %dus / %dus", sRdpSegmentNames[i], busy, total);
+#endif
+        print_small_text(16, posY, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
+        posY += 10;
+    }
+}
+#endif
+
 struct PuppyPrintPage ppPages[] = {
     {&puppyprint_render_standard,  "Standard" },
     {&puppyprint_render_minimal,   "Minimal"  },
@@ -655,6 +736,9 @@ struct PuppyPrintPage ppPages[] = {
     {&print_ram_overview,          "Segments" },
     {&puppyprint_render_collision, "Collision"},
     {&print_console_log,           "Log"      },
+#ifdef PUPPYPRINT_RDP_MARKERS
+    {&puppyprint_render_rdp_layers, "RDP Layers"},
+#endif
 };
 
 #define MENU_BOX_WIDTH 128
@@ -785,6 +869,12 @@ void puppyprint_profiler_process(void) {
         get_average_perf_time(bufferTime, TRUE);
         get_average_perf_time(  tmemTime, TRUE);
         get_average_perf_time(   busTime, TRUE);
+#ifdef PUPPYPRINT_RDP_MARKERS
+        for (s32 i = 0; i < RDP_SEGMENT_COUNT; i++) {
+            get_average_perf_time( rdpSegmentBusyTime[i], TRUE);
+            get_average_perf_time(rdpSegmentTotalTime[i], FALSE);
+        }
+#endif
 
         rdpTime = bufferTime[NUM_PERF_ITERATIONS];
         rdpTime = MAX(rdpTime, tmemTime[NUM_PERF_ITERATIONS]);
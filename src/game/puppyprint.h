@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sm64.h"
 #include "segment2.h"
 
 // This is how many indexes of timers are saved at once. higher creates a smoother average, but naturally uses more RAM. 15's fine.
@@ -32,6 +33,17 @@ enum PuppyprintTextAlign {
     PRINT_ALL               = -1,
 };
 
+#ifdef PUPPYPRINT_RDP_MARKERS
+// The parts of a frame that the RDP's time is split into, see puppyprint_rdp_marker.
+enum RdpMarkerSegments {
+    RDP_SEGMENT_BACKGROUND, // Everything before the master list, such as clearing the screen and the skybox.
+    RDP_SEGMENT_LAYER_FIRST,
+    RDP_SEGMENT_LAYER_LAST = (RDP_SEGMENT_LAYER_FIRST + LAYER_LAST),
+    RDP_SEGMENT_OTHER, // Everything after the master list, such as the HUD.
+    RDP_SEGMENT_COUNT
+};
+#endif
+
 #if PUPPYPRINT_DEBUG
 #if defined(BETTER_REVERB) && (defined(VERSION_US) || defined(VERSION_JP))
 #define NUM_AUDIO_POOLS 7
@@ -46,7 +58,9 @@ enum PuppyFont {
     FONT_NUM,
 };
 
+extern u8 fDebug;
 extern u8 sPPDebugPage;
+extern struct PuppyPrintPage ppPages[];
 extern u8 gPuppyFont;
 extern s8 perfIteration;
 extern s16 benchmarkLoop;
@@ -85,11 +99,23 @@ extern u32    rspGenTime[NUM_PERF_ITERATIONS + 1];
 extern u32    bufferTime[NUM_PERF_ITERATIONS + 1];
 extern u32      tmemTime[NUM_PERF_ITERATIONS + 1];
 extern u32       busTime[NUM_PERF_ITERATIONS + 1];
+#ifdef PUPPYPRINT_RDP_MARKERS
+extern u32 rdpSegmentBusyTime[RDP_SEGMENT_COUNT][NUM_PERF_ITERATIONS + 1];
+extern u32 rdpSegmentTotalTime[RDP_SEGMENT_COUNT][NUM_PERF_ITERATIONS + 1];
+#endif
 
 extern void profiler_update(u32 *time, OSTime time2);
 extern void puppyprint_profiler_process(void);
 extern void puppyprint_render_profiler(void);
 extern void puppyprint_profiler_finished(void);
+#ifdef PUPPYPRINT_RDP_MARKERS
+extern void puppyprint_rdp_marker(s32 segment);
+extern void puppyprint_rdp_markers_reset(void);
+extern void puppyprint_rdp_markers_task_started(struct SPTask *task);
+extern s32  puppyprint_rdp_marker_reached(struct SPTask *task);
+extern s32  puppyprint_rdp_idle(void);
+extern void puppyprint_render_rdp_layers(void);
+#endif
 extern void print_set_envcolour(s32 r, s32 g, s32 b, s32 a);
 extern void prepare_blank_box(void);
 extern void finish_blank_box(void);
@@ -0,0 +1,134 @@
+#include <ultra64.h>
+
+#include "config.h"
+#include "game_init.h"
+#include "puppyprint.h"
+
+#ifdef PUPPYPRINT_RDP_MARKERS
+#include "buffers/buffers.h"
+
+// The most markers read back in one frame, any past this aren't inserted.
+#define RDP_MARKERS_MAX 64
+
+struct RdpMarkerList {
+    u8 segments[RDP_MARKERS_MAX]; // The segment each marker ends, in display list order.
+    u8 count;
+    u8 reached;
+};
+
+// One list for each gfx pool, since the RDP draws one frame while the next one is being built.
+static struct RdpMarkerList sRdpMarkerLists[ARRAY_COUNT(gGfxPools)];
+static u32 sRdpSegmentBusy[RDP_SEGMENT_COUNT];
+static u32 sRdpSegmentTotal[RDP_SEGMENT_COUNT];
+static u32 sRdpLastPipeBusy;
+static OSTime sRdpLastMarkerTime;
+
+static struct RdpMarkerList *get_rdp_marker_list(struct SPTask *task) {
+    u32 i;
+
+    for (i = 0; i < ARRAY_COUNT(gGfxPools); i++) {
+        if (task == &gGfxPools[i].spTask) {
+            return &sRdpMarkerLists[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Clear the markers of the gfx pool that's about to be written to.
+ */
+void puppyprint_rdp_markers_reset(void) {
+    struct RdpMarkerList *list = &sRdpMarkerLists[gGfxPool - gGfxPools];
+
+    list->count   = 0;
+    list->reached = 0;
+}
+
+/**
+ * Insert a full sync that raises a DP interrupt once the RDP has finished
+ * everything before it, which ends the given segment of the frame.
+ * Markers are only inserted while the RDP Layers page is open.
+ */
+void puppyprint_rdp_marker(s32 segment) {
+    struct RdpMarkerList *list = &sRdpMarkerLists[gGfxPool - gGfxPools];
+
+    if (!fDebug || ppPages[sPPDebugPage].func != &puppyprint_render_rdp_layers || list->count >= RDP_MARKERS_MAX) {
+        return;
+    }
+
+    list->segments[list->count++] = segment;
+    gDPFullSync(gDisplayListHead++);
+}
+
+/**
+ * Called by the scheduler when a gfx task starts for the first time, rather than resuming after a yield.
+ */
+void puppyprint_rdp_markers_task_started(struct SPTask *task) {
+    struct RdpMarkerList *list = get_rdp_marker_list(task);
+
+    if (list != NULL) {
+        list->reached = 0;
+    }
+    sRdpLastPipeBusy   = IO_READ(DPC_PIPEBUSY_REG);
+    sRdpLastMarkerTime = osGetTime();
+}
+
+/**
+ * Whether the RDP has run out of commands and gone idle.
+ */
+s32 puppyprint_rdp_idle(void) {
+    return (!(IO_READ(DPC_STATUS_REG) & (DPC_STATUS_CMD_BUSY | DPC_STATUS_PIPE_BUSY))
+            && IO_READ(DPC_CURRENT_REG) == IO_READ(DPC_END_REG));
+}
+
+/**
+ * Called by the scheduler for every DP interrupt while a gfx task is running.
+ * Adds the time since the previous marker to the segment that just ended.
+ * Returns TRUE if the interrupt came from a marker, so the task is still running.
+ * The task is only considered finished once the RSP is done and the RDP is idle,
+ * so merged or late interrupts can't leave the task waiting forever.
+ * If the RDP gets there before the RSP reports in, handle_sp_complete ends the task.
+ */
+s32 puppyprint_rdp_marker_reached(struct SPTask *task) {
+    u32 pipeBusy = IO_READ(DPC_PIPEBUSY_REG);
+    OSTime now = osGetTime();
+    struct RdpMarkerList *list = get_rdp_marker_list(task);
+    s32 finished = (task->state == SPTASK_STATE_FINISHED && puppyprint_rdp_idle());
+    s32 segment = RDP_SEGMENT_OTHER;
+    s32 i;
+
+    if (list == NULL) {
+        return FALSE;
+    }
+
+    if (list->reached >= list->count) {
+        finished = TRUE;
+    } else if (!finished) {
+        segment = list->segments[list->reached++];
+    }
+
+    // The profiler clears the RDP counters once a frame, possibly in the middle of a segment.
+    if (pipeBusy < sRdpLastPipeBusy) {
+        sRdpSegmentBusy[segment] += pipeBusy;
+    } else {
+        sRdpSegmentBusy[segment] += (pipeBusy - sRdpLastPipeBusy);
+    }
+    sRdpSegmentTotal[segment] += (now - sRdpLastMarkerTime);
+    sRdpLastPipeBusy   = pipeBusy;
+    sRdpLastMarkerTime = now;
+
+    if (!finished) {
+        return TRUE;
+    }
+
+    for (i = 0; i < RDP_SEGMENT_COUNT; i++) {
+         rdpSegmentBusyTime[i][perfIteration] = sRdpSegmentBusy[i];
+        rdpSegmentTotalTime[i][perfIteration] = sRdpSegmentTotal[i];
+        sRdpSegmentBusy[i]  = 0;
+        sRdpSegmentTotal[i] = 0;
+    }
+
+    return FALSE;
+}
+#endif
@@ -268,6 +268,67 @@ void switch_ucode(s32 ucode) {
 }
 #endif
 
+#ifdef TRANSPARENT_OBJECT_BATCHING
+/**
+ * Draw the display list batches on the current layer. Each material of a batch
+ * is set up once, followed by the geometry of every instance using it.
+ */
+static void geo_process_display_list_batches(struct DisplayListBatchInstance *instances) {
+    struct DisplayListBatchInstance *instance;
+    struct DisplayListBatchInstance *remaining;
+    struct DisplayListBatchInstance **remainingTail;
+    const struct DisplayListBatch *batch;
+    s32 prevAlpha;
+    s32 prevDither;
+    s32 i;
+
+    while (instances != NULL) {
+        batch = instances->batch;
+        prevAlpha = -1;
+        prevDither = -1;
+
+        for (i = 0; i < batch->numMaterials; i++) {
+            gSPDisplayList(gDisplayListHead++, batch->materials[i]);
+
+            for (instance = instances; instance != NULL; instance = instance->next) {
+                if (instance->batch != batch) {
+                    continue;
+                }
+
+                gSPMatrix(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(instance->transform),
+                          (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+                if (instance->dither != prevDither) {
+                    gDPSetAlphaCompare(gDisplayListHead++, (instance->dither ? G_AC_DITHER : G_AC_NONE));
+                    prevDither = instance->dither;
+                }
+                if (instance->alpha != prevAlpha) {
+                    gDPSetEnvColor(gDisplayListHead++, 255, 255, 255, instance->alpha);
+                    prevAlpha = instance->alpha;
+                }
+                gSPDisplayList(gDisplayListHead++, batch->geometry[i]);
+            }
+        }
+
+        gSPDisplayList(gDisplayListHead++, batch->end);
+        if (prevDither) {
+            gDPSetAlphaCompare(gDisplayListHead++, G_AC_NONE);
+        }
+
+        // Continue with the instances of the other batches.
+        remaining = NULL;
+        remainingTail = &remaining;
+        for (instance = instances; instance != NULL; instance = instance->next) {
+            if (instance->batch != batch) {
+                *remainingTail = instance;
+                remainingTail = &instance->next;
+            }
+        }
+        *remainingTail = NULL;
+        instances = remaining;
+    }
+}
+#endif
+
 /**
  * Process a master list node. This has been modified, so now it runs twice, for each microcode.
  * It iterates through the first 5 layers of if the first index using F3DLX2.Rej, then it switches
@@ -299,6 +360,9 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
  #endif
 #endif // F3DEX_GBI_2
 
+#ifdef PUPPYPRINT_RDP_MARKERS
+    puppyprint_rdp_marker(RDP_SEGMENT_BACKGROUND);
+#endif
     // Loop through the render phases
     for (phaseIndex = RENDER_PHASE_FIRST; phaseIndex < RENDER_PHASE_END; phaseIndex++) {
         // Get the render phase information.
@@ -358,6 +422,19 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
                 // Move to the next DisplayListNode.
                 currList = currList->next;
             }
+#ifdef TRANSPARENT_OBJECT_BATCHING
+ #if SILHOUETTE
+            // Batches are never on silhouette layers, so they are only drawn outside the silhouette phase.
+            if (phaseIndex != RENDER_PHASE_SILHOUETTE) {
+                geo_process_display_list_batches(node->batchHeads[ucode][currLayer]);
+            }
+ #else
+            geo_process_display_list_batches(node->batchHeads[ucode][currLayer]);
+ #endif
+#endif
+#ifdef PUPPYPRINT_RDP_MARKERS
+            puppyprint_rdp_marker(RDP_SEGMENT_LAYER_FIRST + currLayer);
+#endif
         }
     }
 
@@ -378,6 +455,32 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
 #endif
 }
 
+#ifdef TRANSPARENT_OBJECT_BATCHING
+/**
+ * Adds an instance of a display list batch to the master list, with the
+ * current transformation matrix, the given opacity, and whether it is dithered.
+ */
+void geo_append_display_list_batch_instance(const struct DisplayListBatch *batch, s32 layer, u8 alpha, u8 dither) {
+    s32 ucode = GRAPH_NODE_UCODE_DEFAULT;
+#ifdef OBJECTS_REJ
+    if (gCurGraphNodeObject != NULL) {
+        ucode = gCurGraphNodeObject->ucode;
+    }
+#endif
+    if (gCurGraphNodeMasterList != NULL) {
+        struct DisplayListBatchInstance *instance =
+            alloc_only_pool_alloc(gDisplayListHeap, sizeof(struct DisplayListBatchInstance));
+
+        instance->transform = gMatStackFixed[gMatStackIndex];
+        instance->batch = batch;
+        instance->alpha = alpha;
+        instance->dither = dither;
+        instance->next = gCurGraphNodeMasterList->batchHeads[ucode][layer];
+        gCurGraphNodeMasterList->batchHeads[ucode][layer] = instance;
+    }
+}
+#endif
+
 /**
  * Appends the display list to one of the master lists based on the layer
  * parameter. Look at the RenderModeContainer struct to see the corresponding
@@ -453,6 +556,9 @@ void geo_process_master_list(struct GraphNodeMasterList *node) {
         for (ucode = 0; ucode < GRAPH_NODE_NUM_UCODES; ucode++) {
             for (layer = LAYER_FIRST; layer < LAYER_COUNT; layer++) {
                 node->listHeads[ucode][layer] = NULL;
+#ifdef TRANSPARENT_OBJECT_BATCHING
+                node->batchHeads[ucode][layer] = NULL;
+#endif
             }
         }
         geo_process_node_and_siblings(node->node.children);
@@ -672,6 +778,139 @@ void geo_process_display_list(struct GraphNodeDisplayList *node) {
     gMatStackIndex++;
 }
 
+#ifdef GEO_MEMOIZATION
+// The number of cached lists, the most a cached list and the memory it allocates can take up,
+// and the largest key a list can be cached under.
+#define GEO_MEMO_ENTRIES   32
+#define GEO_MEMO_WAYS      4
+#define GEO_MEMO_SETS      (GEO_MEMO_ENTRIES / GEO_MEMO_WAYS)
+#define GEO_MEMO_LIST_SIZE 0x400
+#define GEO_MEMO_KEY_SIZE  0x80
+#define GEO_MEMO_HASH_INIT 2166136261U
+
+struct GeoMemoEntry {
+    ALIGNED8 u8 buffer[GEO_MEMO_LIST_SIZE];
+    ALIGNED8 u8 key[GEO_MEMO_KEY_SIZE];
+    struct GraphNode *node;
+    u32 variant;
+    u32 keySize;
+    u32 lastFrame;
+    Gfx *list; // NULL if the entry is free
+    void *data;
+};
+
+static struct GeoMemoEntry sGeoMemoEntries[GEO_MEMO_SETS][GEO_MEMO_WAYS];
+static struct GeoMemoEntry *sGeoMemoBuildEntry = NULL;
+static u8 *sGeoMemoSavedPoolEnd;
+static Gfx *sGeoMemoSavedDisplayListHead;
+
+/**
+ * Clear every cached list. Called when the level is unloaded, since its nodes go away with it.
+ */
+void geo_memo_clear(void) {
+    bzero(sGeoMemoEntries, sizeof(sGeoMemoEntries));
+    sGeoMemoBuildEntry = NULL;
+}
+
+/**
+ * FNV-1a hash of the given bytes, to pick the set a key goes in.
+ */
+static u32 geo_memo_hash(u32 hash, const void *data, u32 size) {
+    const u8 *bytes = data;
+
+    while (size-- != 0) {
+        hash = ((hash ^ *bytes++) * 16777619U);
+    }
+    return hash;
+}
+
+/**
+ * Look up the display list a generated list function built for the node, where the key holds
+ * everything that goes into the list, and is compared in full. The variant tells apart lists
+ * built from the same key, such as copies for alternate frames. Returns the cached list if there
+ * is one, which the function can return right away. Otherwise returns NULL, and the function builds
+ * its list as usual, then returns it through geo_memo_end. Everything it allocates in between is
+ * kept with the list, so it must not allocate more than maxSize bytes, and must not depend on the
+ * matrix stack. Keys longer than GEO_MEMO_KEY_SIZE aren't cached, and their lists are built every frame.
+ * If data isn't NULL, it is set to what was passed to geo_memo_end along with a cached list.
+ */
+Gfx *geo_memo_begin(struct GraphNode *node, u32 variant, const void *key, u32 keySize, u32 maxSize, void **data) {
+    u32 hash = geo_memo_hash((GEO_MEMO_HASH_INIT ^ variant), key, keySize);
+    struct GeoMemoEntry *set = sGeoMemoEntries[((((uintptr_t) node) >> 3) ^ (hash * 2654435761U)) % GEO_MEMO_SETS];
+    struct GeoMemoEntry *entry = NULL;
+    s32 i;
+
+    if (keySize > GEO_MEMO_KEY_SIZE) {
+        return NULL;
+    }
+
+    for (i = 0; i < GEO_MEMO_WAYS; i++) {
+        if (set[i].list != NULL && set[i].node == node && set[i].variant == variant
+            && set[i].keySize == keySize && memcmp(set[i].key, key, keySize) == 0) {
+            set[i].lastFrame = gGlobalTimer;
+            if (data != NULL) {
+                *data = set[i].data;
+            }
+            return set[i].list;
+        }
+    }
+
+    if (maxSize > GEO_MEMO_LIST_SIZE) {
+        return NULL;
+    }
+
+    // Lists drawn last frame may still be read by the RCP, so only older ones are replaced.
+    for (i = 0; i < GEO_MEMO_WAYS; i++) {
+        if (set[i].list == NULL) {
+            entry = &set[i];
+            break;
+        }
+        if ((gGlobalTimer - set[i].lastFrame) > 1 && (entry == NULL || set[i].lastFrame < entry->lastFrame)) {
+            entry = &set[i];
+        }
+    }
+
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    entry->node = node;
+    entry->variant = variant;
+    entry->keySize = keySize;
+    memcpy(entry->key, key, keySize);
+    entry->list = NULL;
+
+    // Point alloc_display_list at the entry until geo_memo_end.
+    sGeoMemoBuildEntry = entry;
+    sGeoMemoSavedPoolEnd = gGfxPoolEnd;
+    sGeoMemoSavedDisplayListHead = gDisplayListHead;
+    gGfxPoolEnd = (entry->buffer + GEO_MEMO_LIST_SIZE);
+    gDisplayListHead = (Gfx *) entry->buffer;
+
+    return NULL;
+}
+
+/**
+ * Keep the list built since geo_memo_begin, and return it. The data is returned by geo_memo_begin
+ * along with the list, such as the parts of it the function updates in place.
+ */
+Gfx *geo_memo_end(Gfx *list, void *data) {
+    struct GeoMemoEntry *entry = sGeoMemoBuildEntry;
+
+    if (entry != NULL) {
+        gGfxPoolEnd = sGeoMemoSavedPoolEnd;
+        gDisplayListHead = sGeoMemoSavedDisplayListHead;
+
+        entry->list = list;
+        entry->data = data;
+        entry->lastFrame = gGlobalTimer;
+        sGeoMemoBuildEntry = NULL;
+    }
+
+    return list;
+}
+#endif
+
 /**
  * Process a generated list. Instead of storing a pointer to a display list,
  * the list is generated on the fly by a function.
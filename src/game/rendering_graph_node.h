@@ -86,5 +86,13 @@ enum AnimType {
 
 void geo_process_node_and_siblings(struct GraphNode *firstNode);
 void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor);
+#ifdef GEO_MEMOIZATION
+Gfx *geo_memo_begin(struct GraphNode *node, u32 variant, const void *key, u32 keySize, u32 maxSize, void **data);
+Gfx *geo_memo_end(Gfx *list, void *data);
+void geo_memo_clear(void);
+#endif
+#ifdef TRANSPARENT_OBJECT_BATCHING
+void geo_append_display_list_batch_instance(const struct DisplayListBatch *batch, s32 layer, u8 alpha, u8 dither);
+#endif
 
 #endif // RENDERING_GRAPH_NODE_H
@@ -94,6 +94,9 @@ void clear_object_lists(struct ObjectNode *objLists) {
 void unload_object(struct Object *obj) {
     obj->activeFlags = ACTIVE_FLAG_DEACTIVATED;
     obj->prevObj = NULL;
+#ifdef OBJECT_UPDATE_BATCHING
+    unschedule_batched_object_update(obj);
+#endif
 
     obj->header.gfx.throwMatrix = NULL;
     stop_sounds_from_source(obj->header.gfx.cameraToObject);
@@ -195,6 +198,9 @@ struct Object *allocate_object(struct ObjectNode *objList) {
 #ifdef PUPPYLIGHTS
     obj->oLightID = 0xFFFF;
 #endif
+#ifdef WALL_CLEARANCE_CACHE
+    obj->wallClearance.dist = 0.0f;
+#endif
 
     return obj;
 }
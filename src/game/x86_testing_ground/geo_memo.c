@@ -0,0 +1,267 @@
+// Draws water boxes through GEO_MEMOIZATION, and checks that every frame's list draws the same as a list
+// built from scratch, as the water levels change and the textures rotate.
+// Build and run from this directory:
+// FLAGS="-w -D_LANGUAGE_C -DF3DEX_GBI_2 -DVERSION_US -DNON_MATCHING -DAVOID_UB -include geo_memo_config.h
+//     -I../../../include -I../../../include/n64 -I../../../include/hvqm -I../.. -I../../.. -I../../../build/us"
+// gcc $FLAGS -ffunction-sections -fdata-sections -Wl,--gc-sections geo_memo.c -o geo_memo && ./geo_memo
+// Lists are compared by following them and recording their commands and the vertices they load.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../rendering_graph_node.c"
+#include "../moving_texture.c"
+#include "trig_tables.inc.c"
+
+#define NUM_FRAMES    48
+#define POOL_SIZE     0x4000
+#define MAX_TRACE     0x1000
+
+/* Level data stand-ins */
+
+#define MOVTEX_STUB(name) Movtex name[1];
+MOVTEX_STUB(bbh_movtex_merry_go_round_water_entrance)
+MOVTEX_STUB(bbh_movtex_merry_go_round_water_side)
+MOVTEX_STUB(ccm_movtex_penguin_puddle_water)
+MOVTEX_STUB(inside_castle_movtex_green_room_water)
+MOVTEX_STUB(inside_castle_movtex_moat_water)
+MOVTEX_STUB(hmc_movtex_dorrie_pool_water)
+MOVTEX_STUB(hmc_movtex_toxic_maze_mist)
+MOVTEX_STUB(ssl_movtex_puddle_water)
+MOVTEX_STUB(ssl_movtex_toxbox_quicksand_mist)
+MOVTEX_STUB(sl_movtex_water)
+MOVTEX_STUB(wdw_movtex_area2_water)
+MOVTEX_STUB(jrb_movtex_water)
+MOVTEX_STUB(jrb_movtex_initial_mist)
+MOVTEX_STUB(jrb_movtex_sunken_ship_water)
+MOVTEX_STUB(thi_movtex_area1_water)
+MOVTEX_STUB(thi_movtex_area2_water)
+MOVTEX_STUB(castle_grounds_movtex_water)
+MOVTEX_STUB(lll_movtex_volcano_floor_lava)
+MOVTEX_STUB(ddd_movtex_area1_water)
+MOVTEX_STUB(ddd_movtex_area2_water)
+MOVTEX_STUB(wf_movtex_water)
+MOVTEX_STUB(castle_courtyard_movtex_star_statue_water)
+MOVTEX_STUB(ttm_movtex_puddle)
+
+// Filled in with the quad collection below.
+ALIGNED8 Movtex wdw_movtex_area1_water[0x20];
+
+Texture texture_waterbox_water[1], texture_waterbox_mist[1], texture_waterbox_jrb_water[1];
+Texture texture_waterbox_unknown_water[1], texture_waterbox_lava[1];
+Texture ssl_pyramid_sand[1], ssl_quicksand[1], ttc_yellow_triangle[1];
+
+Gfx dl_waterbox_rgba16_begin[] = { gsDPPipeSync(), gsSPEndDisplayList() };
+Gfx dl_waterbox_ia16_begin[]   = { gsDPPipeSync(), gsDPPipeSync(), gsSPEndDisplayList() };
+Gfx dl_waterbox_end[]          = { gsDPPipeSync(), gsDPPipeSync(), gsDPPipeSync(), gsSPEndDisplayList() };
+Gfx dl_draw_quad_verts_0123[]  = { gsSP2Triangles(0, 1, 2, 0x0, 0, 2, 3, 0x0), gsSPEndDisplayList() };
+
+// rot, rotspeed, scale, x1, z1, x2, z2, x3, z3, x4, z4, rotDir, alpha, textureId
+static const s16 sQuadsA[] = {
+    2,
+    0,      0x120, 1, -100, -100, 100, -100, 100, 100, -100, 100, ROTATE_CLOCKWISE,         0xB4, TEXTURE_WATER,
+    0x4000, -0x80, 2, -300, -300, 300, -300, 300, 300, -300, 300, ROTATE_COUNTER_CLOCKWISE, 0x80, TEXTURE_WATER,
+};
+static const s16 sQuadsB[] = {
+    1,
+    0x1000, 0x200, 1, 500, 500, 700, 500, 700, 700, 500, 700, ROTATE_CLOCKWISE,            0xFF, TEXTURE_MIST,
+};
+static s16 sQuadArrA[ARRAY_COUNT(sQuadsA)];
+static s16 sQuadArrB[ARRAY_COUNT(sQuadsB)];
+
+/* Game state stand-ins */
+
+Gfx *gDisplayListHead;
+u8 *gGfxPoolEnd;
+u32 gGlobalTimer;
+TerrainData *gEnvironmentRegions;
+struct LakituState gLakituState;
+s16 gCurrSaveFileNum = 1;
+
+u32 save_file_get_star_flags(UNUSED s32 fileIndex, UNUSED s32 courseIndex) { return 0; }
+void *segmented_to_virtual(const void *addr) { return (void *) addr; }
+
+/* memory.c and geo_misc.c stand-ins, those files need the N64 */
+
+void *alloc_display_list(u32 size) {
+    void *ptr = NULL;
+
+    size = ((size + 7) & ~7);
+    if (gGfxPoolEnd - size >= (u8 *) gDisplayListHead) {
+        gGfxPoolEnd -= size;
+        ptr = gGfxPoolEnd;
+    }
+    return ptr;
+}
+
+void make_vertex(Vtx *vtx, s32 n, s16 x, s16 y, s16 z, s16 tx, s16 ty, u8 r, u8 g, u8 b, u8 a) {
+    vtx[n].v.ob[0] = x;
+    vtx[n].v.ob[1] = y;
+    vtx[n].v.ob[2] = z;
+    vtx[n].v.flag = 0;
+    vtx[n].v.tc[0] = tx;
+    vtx[n].v.tc[1] = ty;
+    vtx[n].v.cn[0] = r;
+    vtx[n].v.cn[1] = g;
+    vtx[n].v.cn[2] = b;
+    vtx[n].v.cn[3] = a;
+}
+
+/* Test setup */
+
+struct Trace {
+    uintptr_t words[MAX_TRACE];
+    s32 count;
+};
+
+static ALIGNED8 u8 sPool[POOL_SIZE];
+static struct GraphNodeGenerated sNode;
+static s16 sRegions[1 + 2 * 6];
+static s32 sFailures;
+
+static void trace_add(struct Trace *trace, uintptr_t word) {
+    if (trace->count < MAX_TRACE) {
+        trace->words[trace->count++] = word;
+    }
+}
+
+// Follows the list the way the RSP would, recording what it draws rather than where it is.
+static void trace_list(struct Trace *trace, Gfx *gfx) {
+    s32 i;
+
+    for (;; gfx++) {
+        switch ((gfx->words.w0 >> 24) & 0xFF) {
+            case G_DL:
+                trace_list(trace, (Gfx *) gfx->words.w1);
+                if (((gfx->words.w0 >> 16) & 0xFF) == G_DL_NOPUSH) {
+                    return;
+                }
+                break;
+            case G_VTX:
+                trace_add(trace, gfx->words.w0);
+                for (i = 0; i < (s32) ((gfx->words.w0 >> 12) & 0xFF); i++) {
+                    Vtx_t *v = &((Vtx *) gfx->words.w1)[i].v;
+                    trace_add(trace, (((u16) v->ob[0] << 16) | (u16) v->ob[1]));
+                    trace_add(trace, (((u16) v->ob[2] << 16) | (u16) v->tc[0]));
+                    trace_add(trace, (((u16) v->tc[1] << 16) | (v->cn[0] << 8) | v->cn[3]));
+                }
+                break;
+            case G_ENDDL:
+                return;
+            default:
+                trace_add(trace, gfx->words.w0);
+                trace_add(trace, gfx->words.w1);
+                break;
+        }
+    }
+}
+
+static void reset(void) {
+    struct MovtexQuadCollection *collection = (struct MovtexQuadCollection *) wdw_movtex_area1_water;
+
+    memcpy(sQuadArrA, sQuadsA, sizeof(sQuadsA));
+    memcpy(sQuadArrB, sQuadsB, sizeof(sQuadsB));
+    collection[0].id = 1;
+    collection[0].quadArraySegmented = sQuadArrA;
+    collection[1].id = 2;
+    collection[1].quadArraySegmented = sQuadArrB;
+    collection[2].id = -1;
+
+    sRegions[0] = 2;
+    sRegions[1] = 1;
+    sRegions[7] = 2;
+    gEnvironmentRegions = sRegions;
+    sNode.parameter = WDW_MOVTEX_AREA1_WATER;
+    gGlobalTimer = 0;
+    gMovtexCounter = 1;
+    gMovtexCounterPrev = 0;
+    geo_memo_clear();
+}
+
+// The set geo_memo_begin looks in for the node and the current water levels.
+static u32 memo_set(u32 variant) {
+    u32 hash = geo_memo_hash((GEO_MEMO_HASH_INIT ^ variant), sRegions, sizeof(sRegions));
+
+    return (((((uintptr_t) &sNode) >> 3) ^ (hash * 2654435761U)) % GEO_MEMO_SETS);
+}
+
+// The water rises, stops, and goes back down to where it was, and the game is paused for a while.
+// The second box then goes away for a while, with an id that isn't in the quad collection. The id is
+// picked so that its list is cached in the same set as the starting one, the way a hash collision
+// would, so that the lists have to be told apart by their key.
+static void set_frame(s32 frame) {
+    u32 set;
+
+    sRegions[6] = ((frame >= 12 && frame < 24) ? (100 + frame) : 100);
+    sRegions[7] = 2;
+    sRegions[12] = ((frame >= 18 && frame < 30) ? 400 : -200);
+    if (frame >= 30 && frame < 34) {
+        set = memo_set((gGlobalTimer + 1) & 1);
+        do {
+            sRegions[7]++;
+        } while (memo_set((gGlobalTimer + 1) & 1) != set);
+    }
+
+    gGlobalTimer++;
+    if (frame < 36 || frame >= 42) {
+        gMovtexCounterPrev = gMovtexCounter;
+        gMovtexCounter++;
+    } else {
+        gMovtexCounterPrev = gMovtexCounter;
+    }
+    gDisplayListHead = (Gfx *) sPool;
+    gGfxPoolEnd = (sPool + POOL_SIZE);
+}
+
+static Gfx *draw(struct Trace *trace) {
+    Gfx *list = geo_movtex_draw_water_regions(GEO_CONTEXT_RENDER, &sNode.fnNode.node, NULL);
+
+    trace->count = 0;
+    if (list != NULL) {
+        trace_list(trace, list);
+    }
+    return list;
+}
+
+int main(void) {
+    static struct Trace cached[NUM_FRAMES];
+    static struct Trace fresh;
+    static Gfx *lists[NUM_FRAMES];
+    s32 frame;
+
+    // Every frame from the cache.
+    reset();
+    for (frame = 0; frame < NUM_FRAMES; frame++) {
+        set_frame(frame);
+        lists[frame] = draw(&cached[frame]);
+    }
+
+    // The same frames, each built from scratch.
+    reset();
+    for (frame = 0; frame < NUM_FRAMES; frame++) {
+        set_frame(frame);
+        geo_memo_clear();
+        draw(&fresh);
+        if (fresh.count == 0 || fresh.count != cached[frame].count
+            || memcmp(fresh.words, cached[frame].words, (fresh.count * sizeof(uintptr_t))) != 0) {
+            printf("frame %d: the cached list draws something else than a new one\n", frame);
+            sFailures++;
+        }
+    }
+
+    for (frame = 1; frame < NUM_FRAMES; frame++) {
+        if (lists[frame] == lists[frame - 1]) {
+            printf("frame %d: reuses the list drawn last frame\n", frame);
+            sFailures++;
+        }
+    }
+    if (lists[4] != lists[2] || lists[35] != lists[3]) {
+        printf("lists for the same water levels aren't reused\n");
+        sFailures++;
+    }
+
+    if (sFailures == 0) {
+        printf("OK\n");
+    }
+    return (sFailures != 0);
+}
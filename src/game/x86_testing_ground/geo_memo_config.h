@@ -0,0 +1,8 @@
+// Config for building geo_memo.c on the host, included with -include.
+// config_graphics.h is only read once, so the memoization can be turned on here.
+#include "config/config_graphics.h"
+
+#define GEO_MEMOIZATION
+
+// Display lists hold host pointers, so they are followed as they are.
+#define NO_SEGMENTED_MEMORY
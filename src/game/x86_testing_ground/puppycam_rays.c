@@ -0,0 +1,258 @@
+// Replays a camera path through PUPPYCAM_COHERENT_COLLISION and checks that every frame gets the same
+// result as casting the rays in full.
+// Build and run from this directory:
+// FLAGS="-w -D_LANGUAGE_C -DF3DEX_GBI_2 -DVERSION_US -DNON_MATCHING -DAVOID_UB -include puppycam_rays_config.h
+//     -I../../../include -I../../../include/n64 -I../../../include/hvqm -I../.. -I../../.. -I../../../build/us"
+// gcc $FLAGS -ffunction-sections -fdata-sections -Wl,--gc-sections puppycam_rays.c -lm -o puppycam_rays && ./puppycam_rays
+// The level is a handful of planes, cast against by the stand-ins for find_surface_on_ray and
+// resolve_and_return_wall_collisions below.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../puppycam2_rays.c"
+
+#define MAX_SCENE_SURFACES 8
+
+// math.h can't be included next to math_util.h.
+extern float sinf(float x);
+extern float cosf(float x);
+
+SpatialPartitionCell gDynamicSurfacePartition[NUM_CELLS][NUM_CELLS];
+struct Area *gCurrentArea;
+
+static struct Area sAreas[2];
+static struct Surface sStaticSurfaces[2][MAX_SCENE_SURFACES];
+static s32 sNumStaticSurfaces[2];
+static struct Surface sObjectSurface;
+static struct SurfaceNode sObjectNode;
+static s32 sNumCasts;
+static s32 sFailures;
+
+static struct Surface *add_plane(struct Surface *surf, f32 nx, f32 ny, f32 nz, f32 dist) {
+    surf->normal.x = nx;
+    surf->normal.y = ny;
+    surf->normal.z = nz;
+    surf->originOffset = -dist;
+    return surf;
+}
+
+/* math_util.c stand-ins, that file needs MIPS */
+
+void vec3f_copy(Vec3f dest, const Vec3f src) {
+    vec3f_set(dest, src[0], src[1], src[2]);
+}
+
+void vec3f_set(Vec3f dest, const f32 x, const f32 y, const f32 z) {
+    dest[0] = x;
+    dest[1] = y;
+    dest[2] = z;
+}
+
+void vec3f_sum(Vec3f dest, const Vec3f a, const Vec3f b) {
+    vec3f_set(dest, a[0] + b[0], a[1] + b[1], a[2] + b[2]);
+}
+
+/* Stand-ins for the level collision */
+
+static f32 plane_distance(struct Surface *surf, Vec3f pos) {
+    return (surf->normal.x * pos[0] + surf->normal.y * pos[1] + surf->normal.z * pos[2] + surf->originOffset);
+}
+
+static void cast_against(struct Surface *surf, Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec3f hit_pos, f32 *nearest) {
+    f32 start = plane_distance(surf, orig);
+    f32 along = (surf->normal.x * dir[0] + surf->normal.y * dir[1] + surf->normal.z * dir[2]);
+    f32 t;
+
+    if (start <= 0.0f || along >= 0.0f) {
+        return;
+    }
+
+    t = (-start / along);
+    if (t <= 1.0f && t < *nearest) {
+        *nearest = t;
+        *hit_surface = surf;
+        vec3f_set(hit_pos, orig[0] + dir[0] * t, orig[1] + dir[1] * t, orig[2] + dir[2] * t);
+    }
+}
+
+void find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec3f hit_pos, UNUSED s32 flags) {
+    s32 area = (gCurrentArea - sAreas);
+    f32 nearest = 2.0f;
+    struct SurfaceNode *node;
+    s32 i, cellX, cellZ;
+
+    sNumCasts++;
+    *hit_surface = NULL;
+    vec3f_sum(hit_pos, orig, dir);
+
+    for (i = 0; i < sNumStaticSurfaces[area]; i++) {
+        cast_against(&sStaticSurfaces[area][i], orig, dir, hit_surface, hit_pos, &nearest);
+    }
+    for (cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+        for (cellX = 0; cellX < NUM_CELLS; cellX++) {
+            for (node = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS].next; node != NULL; node = node->next) {
+                cast_against(node->surface, orig, dir, hit_surface, hit_pos, &nearest);
+            }
+        }
+    }
+}
+
+void resolve_and_return_wall_collisions(Vec3f pos, UNUSED f32 offset, f32 radius, struct WallCollisionData *collisionData) {
+    s32 area = (gCurrentArea - sAreas);
+    s32 i;
+
+    collisionData->numWalls = 0;
+    for (i = 0; i < sNumStaticSurfaces[area]; i++) {
+        struct Surface *surf = &sStaticSurfaces[area][i];
+        f32 dist = plane_distance(surf, pos);
+
+        if (surf->normal.y == 0.0f && dist < radius) {
+            pos[0] += surf->normal.x * (radius - dist);
+            pos[2] += surf->normal.z * (radius - dist);
+            collisionData->numWalls++;
+        }
+    }
+}
+
+/* Object collision */
+
+static void remove_objects(void) {
+    memset(gDynamicSurfacePartition, 0, sizeof(gDynamicSurfacePartition));
+}
+
+// An object with a wall facing the camera, in the cell of the given position.
+static void place_object(Vec3f pos) {
+    s32 cellX = GET_CELL_COORD(pos[0]);
+    s32 cellZ = GET_CELL_COORD(pos[2]);
+
+    remove_objects();
+    sObjectNode.surface = add_plane(&sObjectSurface, 0.0f, 0.0f, -1.0f, -(pos[2] - 10.0f));
+    sObjectNode.next = NULL;
+    gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS].next = &sObjectNode;
+}
+
+/* Replay */
+
+struct Frame {
+    Vec3f target;
+    s16 yaw;
+    s16 pitch;
+    f32 zoom;
+};
+
+static void frame_rays(struct Frame *frame, Vec3f target[2], Vec3f camdir[2]) {
+    f32 pitch = frame->pitch * (3.14159265f / 0x8000);
+    f32 yaw = frame->yaw * (3.14159265f / 0x8000);
+
+    vec3f_set(target[0], frame->target[0], frame->target[1] + 125.0f, frame->target[2]);
+    vec3f_set(target[1], frame->target[0], frame->target[1] + 50.0f, frame->target[2]);
+    vec3f_set(camdir[0], frame->zoom * sinf(pitch) * sinf(yaw), frame->zoom * cosf(pitch), frame->zoom * sinf(pitch) * cosf(yaw));
+    vec3f_copy(camdir[1], camdir[0]);
+}
+
+// Runs one frame through the cache and through a full cast, returning whether the cache cast any rays.
+static s32 replay_frame(const char *test, s32 frameIndex, struct Frame *frame) {
+    Vec3f target[2], camdir[2];
+    Vec3f hitpos[2], fullHitpos[2];
+    struct Surface *surf[2], *fullSurf[2];
+    s32 castsBefore = sNumCasts;
+    s32 cast;
+
+    frame_rays(frame, target, camdir);
+    puppycam_cast_rays_coherent(target, camdir, surf, hitpos);
+    cast = (sNumCasts != castsBefore);
+    puppycam_cast_rays(target, camdir, fullSurf, fullHitpos);
+
+    if (surf[0] != fullSurf[0] || surf[1] != fullSurf[1] || memcmp(hitpos, fullHitpos, sizeof(hitpos)) != 0) {
+        printf("%s: frame %d differs from a full cast\n", test, frameIndex);
+        sFailures++;
+    }
+    return cast;
+}
+
+static void expect(const char *test, const char *what, s32 value, s32 expected) {
+    if (value != expected) {
+        printf("%s: %s is %d, expected %d\n", test, what, value, expected);
+        sFailures++;
+    }
+}
+
+// The camera follows a path that alternates standing still, walking and turning.
+static void test_path(void) {
+    const char *name = "path";
+    struct Frame frame = { { 0.0f, 0.0f, 0.0f }, 0, 0x3000, 1000.0f };
+    s32 i, numCast = 0, numFrames = 0;
+
+    for (i = 0; i < 240; i++) {
+        switch ((i / 20) % 4) {
+            case 1: frame.target[2] += 7.5f; break;
+            case 3: frame.yaw += 0x180;      break;
+        }
+        numCast += replay_frame(name, i, &frame);
+        numFrames++;
+    }
+
+    expect(name, "frames cast while moving", numCast, (numFrames / 2) + 1);
+}
+
+// An object walks up to the rays while the camera stands still, then leaves.
+static void test_object(void) {
+    const char *name = "object";
+    struct Frame frame = { { 0.0f, 0.0f, 0.0f }, 0, 0x3000, 1000.0f };
+    Vec3f objPos;
+    s32 i;
+
+    puppycam_clear_collision_cache();
+    replay_frame(name, 0, &frame);
+    expect(name, "reused before the object", replay_frame(name, 1, &frame), FALSE);
+
+    // Far from the rays, so the cache is still used.
+    vec3f_set(objPos, 6000.0f, 0.0f, 6000.0f);
+    place_object(objPos);
+    expect(name, "reused with the object far away", replay_frame(name, 2, &frame), FALSE);
+
+    for (i = 3; i < 10; i++) {
+        vec3f_set(objPos, 0.0f, 0.0f, 300.0f);
+        place_object(objPos);
+        expect(name, "reused with the object in front", replay_frame(name, i, &frame), TRUE);
+    }
+
+    remove_objects();
+    expect(name, "reused once the object left", replay_frame(name, 10, &frame), TRUE);
+    expect(name, "reused after that", replay_frame(name, 11, &frame), FALSE);
+}
+
+// The area changes under a camera that stands still.
+static void test_area_change(void) {
+    const char *name = "area change";
+    struct Frame frame = { { 0.0f, 0.0f, 0.0f }, 0, 0x3000, 1000.0f };
+
+    puppycam_clear_collision_cache();
+    gCurrentArea = &sAreas[0];
+    replay_frame(name, 0, &frame);
+    gCurrentArea = &sAreas[1];
+    expect(name, "cast in the new area", replay_frame(name, 1, &frame), TRUE);
+    expect(name, "reused after that", replay_frame(name, 2, &frame), FALSE);
+    gCurrentArea = &sAreas[0];
+}
+
+int main(void) {
+    // A wall behind the camera's start, a floor and a slope. The second area only has the floor.
+    add_plane(&sStaticSurfaces[0][0], 0.0f, 0.0f, -1.0f, -600.0f);
+    add_plane(&sStaticSurfaces[0][1], 0.0f, 1.0f, 0.0f, -100.0f);
+    add_plane(&sStaticSurfaces[0][2], -0.6f, 0.8f, 0.0f, -800.0f);
+    sNumStaticSurfaces[0] = 3;
+    add_plane(&sStaticSurfaces[1][0], 0.0f, 1.0f, 0.0f, -100.0f);
+    sNumStaticSurfaces[1] = 1;
+    gCurrentArea = &sAreas[0];
+
+    test_path();
+    test_object();
+    test_area_change();
+
+    if (sFailures == 0) {
+        printf("OK\n");
+    }
+    return (sFailures != 0);
+}
@@ -0,0 +1,6 @@
+// Config for building puppycam_rays.c on the host, included with -include.
+// config_camera.h is only read once, so the camera options can be turned on here.
+#include "config/config_camera.h"
+
+#define PUPPYCAM
+#define PUPPYCAM_COHERENT_COLLISION
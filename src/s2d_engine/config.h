@@ -17,6 +17,20 @@
 
 #define BASE_SCALE 1.0f
 
+// Keep the layout of deferred strings between frames, and draw them with
+// s2d_flush_deferred instead of s2d_init, s2d_handle_deferred and s2d_stop.
+// Strings without SCALE or ROTATE are drawn with the F3D path, so the S2DEX
+// microcode is only loaded when something needs it, and then only once.
+// #define S2D_CACHE_LAYOUTS
+
+// The number of cached strings, the most glyphs (drop shadows included)
+// a cached string can have, and the longest string that can be cached.
+// Cached strings are compared in full on a hit, so that hash collisions
+// can't draw the wrong text. Longer strings are laid out every frame.
+#define S2D_CACHE_SIZE 8
+#define S2D_CACHE_GLYPHS 48
+#define S2D_CACHE_STR_LEN 128
+
 /******************************
  *
  * ONLY CHANGE THE BELOW CONTENTS IF YOU'RE DEVELOPING
@@ -90,6 +104,9 @@ extern char *proutSprintf(char *dst, const char *src, size_t count);
 #define seg2virt segmented_to_virtual
 #define IS_RUNNING_ON_EMULATOR (IO_READ(DPC_PIPEBUSY_REG) == 0)
 
+// Strings passed to s2d_print have to be in KSEG0
+#define IS_VALID_STR_PTR(p) (((u32)(p) & 0x80000000) != 0)
+
 // Texture resolution (pixels on the texture per pixel on the framebuffer)
 #define TEX_RES 1
 
@@ -1,6 +1,10 @@
 #include "config.h"
 #include "s2d_error.h"
 #include "s2d_print.h"
+#include "s2d_cache.h"
+#include "s2d_draw.h"
+#include "debug.h"
+#include "init.h"
 
 #define S2D_BUFFERSIZE 100
 
@@ -37,3 +41,60 @@ void s2d_handle_deferred(void) {
 	}
 }
 
+#ifdef S2D_CACHE_LAYOUTS
+// Draws the deferred strings from their cached layouts, replacing
+// s2d_init, s2d_handle_deferred and s2d_stop.
+// Strings that the F3D path can draw are drawn first, then the S2DEX
+// microcode is loaded once for the rest, if there are any.
+void s2d_flush_deferred(void) {
+	struct s2d_layout *layouts[S2D_BUFFERSIZE];
+	int drew_f3d = FALSE;
+	int needs_s2dex = FALSE;
+	int i;
+
+	for (i = 0; i < s2d_charBuffer_index; i++) {
+		layouts[i] = s2d_get_layout(
+			s2d_positions[i].x,
+			s2d_positions[i].y,
+			ALIGN_LEFT,
+			s2d_charBuffer[i]
+		);
+		if (layouts[i] == NULL || s2d_layout_needs_s2dex(layouts[i])) {
+			needs_s2dex = TRUE;
+			continue;
+		}
+		if (!drew_f3d) {
+			f3d_rdp_init();
+			drew_f3d = TRUE;
+		}
+		s2d_draw_layout_f3d(layouts[i]);
+	}
+
+	if (!needs_s2dex) {
+		if (drew_f3d && deinit_cond) {
+			my_rdp_init();
+		}
+		s2d_reset_defer_index();
+		return;
+	}
+
+	s2d_init();
+	if (IS_RUNNING_ON_EMULATOR) {
+		s2d_rdp_init();
+	}
+	for (i = 0; i < s2d_charBuffer_index; i++) {
+		if (layouts[i] == NULL) {
+			s2d_print_alloc(
+				s2d_positions[i].x,
+				s2d_positions[i].y,
+				ALIGN_LEFT,
+				s2d_charBuffer[i]
+			);
+		} else if (s2d_layout_needs_s2dex(layouts[i])) {
+			s2d_draw_layout_s2dex(layouts[i]);
+		}
+	}
+	// also resets the defer index
+	s2d_stop();
+}
+#endif
@@ -0,0 +1,208 @@
+#include "config.h"
+#include <ultra64.h>
+#include "mtx.h"
+#include "debug.h"
+#include <string.h>
+
+#include "s2d_cache.h"
+#include "s2d_draw.h"
+#include "s2d_print.h"
+
+#ifdef S2D_CACHE_LAYOUTS
+
+static struct s2d_layout s2d_layouts[S2D_CACHE_SIZE];
+static struct s2d_layout *s2d_cur_layout = NULL;
+
+// FNV-1a, so that strings in reused buffers are looked up by what they say.
+// Also returns the length, which is -1 for strings too long to cache.
+static unsigned int s2d_hash(const char *str, int *len) {
+	unsigned int hash = 2166136261u;
+	const char *p = str;
+
+	while (*p != '\0') {
+		hash ^= (unsigned char) *p++;
+		hash *= 16777619u;
+	}
+	*len = p - str;
+	if (*len >= S2D_CACHE_STR_LEN) *len = -1;
+	return hash;
+}
+
+static int s2d_layout_matches(struct s2d_layout *l, unsigned int hash, int len,
+	                          int x, int y, int align, const char *str) {
+	return l->built && l->hash == hash && l->len == len
+		&& l->x == x && l->y == y && l->align == align
+		&& memcmp(l->str, str, len) == 0;
+}
+
+static int s2d_has_button(const char *str) {
+	const char *p = str;
+
+	while (*p != '\0') {
+		if (*p++ == CH_BUTTON) return TRUE;
+	}
+	return FALSE;
+}
+
+// Called by the parser for every glyph of the layout being built
+void s2d_layout_add_glyph(char c, int x, int y) {
+	struct s2d_layout *l = s2d_cur_layout;
+	struct s2d_glyph *g;
+
+	if ((l->num_glyphs + (drop_shadow ? 2 : 1)) > S2D_CACHE_GLYPHS) {
+		l->overflow = TRUE;
+		return;
+	}
+
+	if (myScale != 1.0f || myDegrees != 0) {
+		l->needs_s2dex = TRUE;
+	}
+
+	if (drop_shadow) {
+		g = &l->glyphs[l->num_glyphs++];
+		g->c = c;
+		g->shadow = TRUE;
+		g->x = x + drop_x;
+		g->y = y + drop_y;
+	}
+
+	g = &l->glyphs[l->num_glyphs++];
+	g->c = c;
+	g->shadow = FALSE;
+	g->x = x;
+	g->y = y;
+
+	for (g = &l->glyphs[l->num_glyphs - (drop_shadow ? 2 : 1)]; g < &l->glyphs[l->num_glyphs]; g++) {
+		g->scale = myScale;
+		g->r = s2d_red;
+		g->g = s2d_green;
+		g->b = s2d_blue;
+		g->a = s2d_alpha;
+		mat2_ident(&g->mtx, 1.0f / myScale);
+		mat2_translate(&g->mtx, g->x, g->y);
+	}
+}
+
+// Entries used this frame or the last one may still be read by the RSP
+static struct s2d_layout *s2d_find_free_layout(void) {
+	struct s2d_layout *oldest = NULL;
+	int i;
+
+	for (i = 0; i < S2D_CACHE_SIZE; i++) {
+		struct s2d_layout *l = &s2d_layouts[i];
+
+		if (!l->built) return l;
+		if ((s2d_timer - l->last_frame) > 1
+			&& (oldest == NULL || l->last_frame < oldest->last_frame)) {
+			oldest = l;
+		}
+	}
+	return oldest;
+}
+
+// Returns NULL for strings that have to go through s2d_print_alloc,
+// which also reports bad strings and alignments.
+struct s2d_layout *s2d_get_layout(int x, int y, int align, const char *str) {
+	struct s2d_layout *l;
+	unsigned int hash;
+	int len;
+	int i;
+
+	if (align < ALIGN_LEFT || align > ALIGN_RIGHT) return NULL;
+	if (str == NULL || !IS_VALID_STR_PTR(str)) return NULL;
+	// button prompts depend on the controller
+	if (s2d_has_button(str)) return NULL;
+
+	hash = s2d_hash(str, &len);
+	if (len < 0) return NULL;
+
+	for (i = 0; i < S2D_CACHE_SIZE; i++) {
+		l = &s2d_layouts[i];
+		if (s2d_layout_matches(l, hash, len, x, y, align, str)) {
+			l->last_frame = s2d_timer;
+			return l;
+		}
+	}
+
+	l = s2d_find_free_layout();
+	if (l == NULL) return NULL;
+
+	l->hash = hash;
+	l->len = len;
+	memcpy(l->str, str, len);
+	l->x = x;
+	l->y = y;
+	l->align = align;
+	l->built = FALSE;
+	l->needs_s2dex = FALSE;
+	l->overflow = FALSE;
+	l->num_glyphs = 0;
+
+	s2d_cur_layout = l;
+	s2d_layout_str(x, y, align, str);
+	s2d_cur_layout = NULL;
+
+	if (l->overflow) return NULL;
+
+	l->built = TRUE;
+	l->last_frame = s2d_timer;
+	return l;
+}
+
+// The S2DEX microcode is only loaded on emulators, see s2d_init
+int s2d_layout_needs_s2dex(struct s2d_layout *layout) {
+	return layout->needs_s2dex && IS_RUNNING_ON_EMULATOR;
+}
+
+static void s2d_set_glyph_color(struct s2d_glyph *g) {
+	s2d_red = g->r;
+	s2d_green = g->g;
+	s2d_blue = g->b;
+	s2d_alpha = g->a;
+	myScale = g->scale;
+}
+
+static void s2d_reset_glyph_color(void) {
+	s2d_red = s2d_green = s2d_blue = 255;
+	s2d_alpha = 255;
+	myScale = 1.0f;
+}
+
+// Drop shadows are drawn first, like s2d_print_alloc does
+void s2d_draw_layout_f3d(struct s2d_layout *layout) {
+	struct s2d_glyph *g;
+	int shadow;
+
+	for (shadow = TRUE; shadow >= FALSE; shadow--) {
+		for (g = layout->glyphs; g < &layout->glyphs[layout->num_glyphs]; g++) {
+			if (g->shadow != shadow) continue;
+			s2d_set_glyph_color(g);
+			if (shadow) {
+				draw_f3d_dropshadow(g->c, g->x, g->y, &g->mtx);
+			} else {
+				draw_f3d_glyph(g->c, g->x, g->y, &g->mtx);
+			}
+		}
+	}
+	s2d_reset_glyph_color();
+}
+
+void s2d_draw_layout_s2dex(struct s2d_layout *layout) {
+	struct s2d_glyph *g;
+	int shadow;
+
+	for (shadow = TRUE; shadow >= FALSE; shadow--) {
+		for (g = layout->glyphs; g < &layout->glyphs[layout->num_glyphs]; g++) {
+			if (g->shadow != shadow) continue;
+			s2d_set_glyph_color(g);
+			if (shadow) {
+				draw_s2d_dropshadow_cached(g->c, &g->mtx);
+			} else {
+				draw_s2d_glyph_cached(g->c, &g->mtx);
+			}
+		}
+	}
+	s2d_reset_glyph_color();
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef S2D_CACHE_H
+#define S2D_CACHE_H
+#include <ultra64.h>
+#include <PR/gs2dex.h>
+
+#include "config.h"
+
+#ifdef S2D_CACHE_LAYOUTS
+
+struct s2d_glyph {
+	uObjMtx mtx; // S2DEX matrix, built once with the layout
+	short x, y;
+	float scale;
+	unsigned char c;
+	unsigned char shadow;
+	unsigned char r, g, b, a;
+};
+
+struct s2d_layout {
+	unsigned int hash;
+	unsigned short len;
+	char str[S2D_CACHE_STR_LEN];
+	short x, y;
+	unsigned char align;
+	unsigned char built;
+	unsigned char needs_s2dex;
+	unsigned char overflow;
+	u32 last_frame;
+	int num_glyphs;
+	struct s2d_glyph glyphs[S2D_CACHE_GLYPHS];
+};
+
+extern int s2d_layout_str(int x, int y, int align, const char *str);
+
+extern struct s2d_layout *s2d_get_layout(int x, int y, int align, const char *str);
+extern void s2d_layout_add_glyph(char c, int x, int y);
+
+extern int s2d_layout_needs_s2dex(struct s2d_layout *layout);
+extern void s2d_draw_layout_f3d(struct s2d_layout *layout);
+extern void s2d_draw_layout_s2dex(struct s2d_layout *layout);
+
+#endif
+
+#endif
@@ -47,19 +47,21 @@ void setup_s2d_texture(int idx) {
     gSPObjLoadTxtr(gdl_head++, &s2d_tex[idx]);
 }
 
-void mtx_pipeline(uObjMtx *m, int x, int y) {
+void mtx_load(uObjMtx *m) {
     gDPPipeSync(gdl_head++);
+    gSPObjSubMatrix(gdl_head++, &m->m.X);
+}
 
+void mtx_pipeline(uObjMtx *m, int x, int y) {
     mat2_ident(m, 1.0f / myScale);
     mat2_translate(m, x, y);
 
-    gSPObjSubMatrix(gdl_head++, &m->m.X);
+    mtx_load(m);
 }
 
 #define CLAMP_0(x) ((x < 0) ? 0 : x)
 
-void draw_s2d_dropshadow(char c, int x, int y, uObjMtx *ds) {
-    if (mtx_cond) mtx_pipeline(ds, x, y);
+static void draw_s2d_dropshadow_rect(char c) {
     if (tex_cond) setup_s2d_texture(c);
 
     if (s2d_red != 0
@@ -77,10 +79,30 @@ void draw_s2d_dropshadow(char c, int x, int y, uObjMtx *ds) {
     }
 }
 
-void draw_s2d_glyph(char c, int x, int y, uObjMtx *mt) {
-    if (mtx_cond) mtx_pipeline(mt, x, y);
+static void draw_s2d_glyph_rect(char c) {
     if (tex_cond) setup_s2d_texture(c);
 
     if (spr_cond) gSPObjRectangleR(gdl_head++, &s2d_font);
 }
 
+void draw_s2d_dropshadow(char c, int x, int y, uObjMtx *ds) {
+    if (mtx_cond) mtx_pipeline(ds, x, y);
+    draw_s2d_dropshadow_rect(c);
+}
+
+void draw_s2d_glyph(char c, int x, int y, uObjMtx *mt) {
+    if (mtx_cond) mtx_pipeline(mt, x, y);
+    draw_s2d_glyph_rect(c);
+}
+
+// For matrices that were already built, see s2d_cache.c
+void draw_s2d_dropshadow_cached(char c, uObjMtx *ds) {
+    if (mtx_cond) mtx_load(ds);
+    draw_s2d_dropshadow_rect(c);
+}
+
+void draw_s2d_glyph_cached(char c, uObjMtx *mt) {
+    if (mtx_cond) mtx_load(mt);
+    draw_s2d_glyph_rect(c);
+}
+
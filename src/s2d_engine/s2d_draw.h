@@ -15,9 +15,16 @@ extern void s2d_rdp_init(void);
 
 extern void setup_font_texture(int idx);
 
+extern void mtx_load(uObjMtx *m);
 extern void mtx_pipeline(uObjMtx *m, int x, int y);
 
 extern void draw_s2d_glyph(char c, int x, int y, uObjMtx *mt);
-extern void draw_s2d_shadow(char c, int x, int y, uObjMtx *ds);
+extern void draw_s2d_dropshadow(char c, int x, int y, uObjMtx *ds);
+extern void draw_s2d_glyph_cached(char c, uObjMtx *mt);
+extern void draw_s2d_dropshadow_cached(char c, uObjMtx *ds);
+
+extern void f3d_rdp_init(void);
+extern void draw_f3d_glyph(char c, int x, int y, uObjMtx *mt);
+extern void draw_f3d_dropshadow(char c, int x, int y, uObjMtx *ds);
 
 #endif
\ No newline at end of file
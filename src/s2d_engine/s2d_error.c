@@ -14,7 +14,7 @@ int s2d_check_align(int align) {
 }
 
 int s2d_check_str(const char *str) {
-	if (str == NULL || ((u32)str & 0x80000000) == 0) {
+	if (str == NULL || !IS_VALID_STR_PTR(str)) {
 		s2d_print_alloc(TEX_WIDTH, s2d_error_y, ALIGN_LEFT, "ERROR: bad string, or no string specified");
 		s2d_error_y += TEX_HEIGHT;
 		return -1;
@@ -9,12 +9,14 @@
 #include "s2d_print.h"
 #include "s2d_ustdlib.h"
 #include "s2d_error.h"
+#include "s2d_cache.h"
 
 static int s2d_width(const char *str, int line, int len);
 
 enum S2DPrintModes {
 	MODE_DRAW_DROPSHADOW,
 	MODE_DRAW_NORMALTEXT,
+	MODE_BUILD_LAYOUT,
 };
 
 static int s2d_snprint(int x, int y, int align, const char *str, uObjMtx *buf, int len, int mode) {
@@ -27,7 +29,9 @@ static int s2d_snprint(int x, int y, int align, const char *str, uObjMtx *buf, i
 
 	if (*p == '\0') return;
 
-	if (IS_RUNNING_ON_EMULATOR) {
+	if (mode == MODE_BUILD_LAYOUT) {
+		// nothing is drawn
+	} else if (IS_RUNNING_ON_EMULATOR) {
 		s2d_rdp_init();
 	} else {
 		f3d_rdp_init();
@@ -166,6 +170,11 @@ static int s2d_snprint(int x, int y, int align, const char *str, uObjMtx *buf, i
 				if (current_char != '\0' && current_char != CH_SEPARATOR) {
 					char *tbl = segmented_to_virtual(s2d_kerning_table);
 
+#ifdef S2D_CACHE_LAYOUTS
+					if (mode == MODE_BUILD_LAYOUT) {
+						s2d_layout_add_glyph(current_char, x, y);
+					} else
+#endif
 					if (IS_RUNNING_ON_EMULATOR) {
 						if (drop_shadow && mode == MODE_DRAW_DROPSHADOW) {
 							draw_s2d_dropshadow(current_char, x + drop_x, y + drop_y, (buf++));
@@ -231,6 +240,13 @@ void s2d_print_alloc(int x, int y, int align, const char *str) {
 	s2d_snprint(x, y, align, str, b2, len, MODE_DRAW_NORMALTEXT);
 }
 
+#ifdef S2D_CACHE_LAYOUTS
+// Parses the string without drawing it, adding each glyph to the layout being built
+int s2d_layout_str(int x, int y, int align, const char *str) {
+	return s2d_snprint(x, y, align, str, NULL, s2d_strlen(str), MODE_BUILD_LAYOUT);
+}
+#endif
+
 // deprecated
 void s2d_type_print(int x, int y, int align, const char *str, uObjMtx *buf, int *pos) {
 	int len;
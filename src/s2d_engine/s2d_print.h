@@ -32,4 +32,7 @@
 #define ALIGN_RIGHT 2
 
 extern void s2d_print_alloc(int x, int y, int align, const char *str);
+extern void s2d_print_deferred(int x, int y, const char *str);
+extern void s2d_handle_deferred(void);
+extern void s2d_flush_deferred(void);
 extern void s2d_type_print(int x, int y, int align, const char *str, uObjMtx *buf, int *pos);
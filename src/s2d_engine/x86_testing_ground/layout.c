@@ -0,0 +1,158 @@
+// Checks that cached layouts draw the same glyphs as s2d_print.
+// Build and run from this directory:
+// gcc -D_LANGUAGE_C -DF3DEX_GBI_2 -I../../../include -I../../../include/n64 -include layout_config.h
+//     layout.c ../s2d_parse.c ../s2d_cache.c ../s2d_ustdlib.c ../mtx.c -lm -o layout && ./layout
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../s2d_draw.h"
+#include "../s2d_print.h"
+#include "../s2d_cache.h"
+
+// deprecated, so not in s2d_print.h
+extern void s2d_print(int x, int y, int align, const char *str, uObjMtx *buf);
+
+struct glyph {
+	char c;
+	int x, y;
+	float scale;
+	int r, g, b, a;
+	int shadow;
+};
+
+static struct glyph drawn[256];
+static int num_drawn;
+
+char test_kerning_table[256];
+Gfx *gdl_head;
+u16 test_buttons;
+u32 test_timer;
+
+float myScale = 1.0f;
+int myDegrees = 0;
+int drop_shadow = FALSE;
+int drop_x = 0, drop_y = 0;
+int s2d_red = 255, s2d_green = 255, s2d_blue = 255, s2d_alpha = 255;
+
+void *test_alloc(size_t size) { return malloc(size); }
+void test_rdp_init(void) {}
+void test_rsp_init(void) {}
+void s2d_rdp_init(void) {}
+void f3d_rdp_init(void) {}
+int s2d_check_align(int align) { return align < ALIGN_LEFT || align > ALIGN_RIGHT; }
+int s2d_check_str(const char *str) { return str == NULL; }
+
+static void record(char c, int x, int y, int shadow) {
+	struct glyph *g = &drawn[num_drawn++];
+
+	g->c = c;
+	g->x = x;
+	g->y = y;
+	g->scale = myScale;
+	g->r = s2d_red;
+	g->g = s2d_green;
+	g->b = s2d_blue;
+	g->a = s2d_alpha;
+	g->shadow = shadow;
+}
+
+void draw_s2d_glyph(char c, int x, int y, uObjMtx *mt) { record(c, x, y, FALSE); }
+void draw_s2d_dropshadow(char c, int x, int y, uObjMtx *ds) { record(c, x, y, TRUE); }
+void draw_f3d_glyph(char c, int x, int y, uObjMtx *mt) { record(c, x, y, FALSE); }
+void draw_f3d_dropshadow(char c, int x, int y, uObjMtx *ds) { record(c, x, y, TRUE); }
+void draw_s2d_glyph_cached(char c, uObjMtx *mt) {}
+void draw_s2d_dropshadow_cached(char c, uObjMtx *ds) {}
+
+// s2d_print draws every drop shadow before the text, so compare in that order
+static int compare_layout(int x, int y, int align, const char *str) {
+	static uObjMtx buf[256];
+	struct s2d_layout *l;
+	struct s2d_glyph *g;
+	int i = 0;
+	int shadow;
+
+	// layouts from the last two frames are never evicted
+	test_timer += 2;
+	num_drawn = 0;
+	s2d_print(x, y, align, str, buf);
+
+	l = s2d_get_layout(x, y, align, str);
+	if (l == NULL) {
+		printf("FAIL: no layout for \"%s\"\n", str);
+		return 1;
+	}
+	if (l->num_glyphs != num_drawn) {
+		printf("FAIL: \"%s\": %d glyphs, expected %d\n", str, l->num_glyphs, num_drawn);
+		return 1;
+	}
+
+	for (shadow = TRUE; shadow >= FALSE; shadow--) {
+		for (g = l->glyphs; g < &l->glyphs[l->num_glyphs]; g++) {
+			struct glyph *d = &drawn[i];
+
+			if (g->shadow != shadow) continue;
+			if (g->c != d->c || g->x != d->x || g->y != d->y || g->scale != d->scale
+				|| g->r != d->r || g->g != d->g || g->b != d->b || g->a != d->a
+				|| g->shadow != d->shadow) {
+				printf("FAIL: \"%s\": glyph %d is '%c' at %d,%d, expected '%c' at %d,%d\n",
+					str, i, g->c, g->x, g->y, d->c, d->x, d->y);
+				return 1;
+			}
+			i++;
+		}
+	}
+	return 0;
+}
+
+int main(void) {
+	static const char *strs[] = {
+		"HELLO WORLD",
+		"LINE ONE\nLINE TWO\tTAB",
+		COLOR "255 0 0 128" "RED " RESET "WHITE",
+		DROPSHADOW "2 2" "SHADOWED",
+		"PLAIN " DROPSHADOW "1 3" "THEN SHADOWED",
+		SCALE "200" "BIG " TRANSLATE "40 80" "MOVED",
+	};
+	char reused[32];
+	struct s2d_layout *a, *b;
+	int failed = 0;
+	int i;
+
+	for (i = 0; i < 256; i++) {
+		test_kerning_table[i] = 4 + (i % 7);
+	}
+
+	for (i = 0; i < (int) (sizeof(strs) / sizeof(strs[0])); i++) {
+		failed |= compare_layout(10, 20, ALIGN_LEFT, strs[i]);
+		failed |= compare_layout(160, 20, ALIGN_CENTER, strs[i]);
+		failed |= compare_layout(300, 20, ALIGN_RIGHT, strs[i]);
+	}
+
+	// a cache hit returns the same layout
+	a = s2d_get_layout(10, 20, ALIGN_LEFT, strs[0]);
+	b = s2d_get_layout(10, 20, ALIGN_LEFT, strs[0]);
+	if (a != b) {
+		printf("FAIL: no cache hit\n");
+		failed = 1;
+	}
+
+	// a buffer that is rewritten in place is looked up by what it says
+	strcpy(reused, "SCORE 100");
+	failed |= compare_layout(10, 40, ALIGN_LEFT, reused);
+	strcpy(reused, "SCORE 200");
+	failed |= compare_layout(10, 40, ALIGN_LEFT, reused);
+	if (s2d_get_layout(10, 40, ALIGN_LEFT, reused)->str[6] != '2') {
+		printf("FAIL: stale layout\n");
+		failed = 1;
+	}
+
+	// button prompts are never cached
+	if (s2d_get_layout(10, 20, ALIGN_LEFT, "PRESS " BUTTON "A") != NULL) {
+		printf("FAIL: cached a button prompt\n");
+		failed = 1;
+	}
+
+	printf(failed ? "FAILED\n" : "OK\n");
+	return failed;
+}
@@ -0,0 +1,51 @@
+// Stand-in for ../config.h when building layout.c on the host.
+// Included with -include, so the real config.h is skipped by its guard.
+#include <ultra64.h>
+#include <PR/gs2dex.h>
+#include <stddef.h>
+
+#define S2D_CONFIG_H
+
+#define S2D_CACHE_LAYOUTS
+#define S2D_CACHE_SIZE 8
+#define S2D_CACHE_GLYPHS 48
+#define S2D_CACHE_STR_LEN 128
+
+#define BASE_SCALE 1.0f
+
+#define s2d_kerning_table test_kerning_table
+extern char s2d_kerning_table[];
+
+extern Gfx *gdl_head;
+
+extern u16 test_buttons;
+#define CONTROLLER_INPUT test_buttons
+#define CONTROLLER_HELD_INPUT test_buttons
+
+#define alloc test_alloc
+extern void *alloc(size_t);
+
+#define my_rdp_init test_rdp_init
+#define my_rsp_init test_rsp_init
+extern void my_rsp_init(void);
+extern void my_rdp_init(void);
+
+#define s2d_timer test_timer
+extern u32 s2d_timer;
+
+#define TAB_WIDTH_H TEX_WIDTH * 2
+#define TAB_WIDTH_V TEX_WIDTH / 2
+
+#define TEX_WIDTH 16
+#define TEX_HEIGHT 16
+#define TEX_BITDEPTH 8
+
+#define segmented_to_virtual(p) ((void *)(p))
+#define seg2virt segmented_to_virtual
+#define IS_RUNNING_ON_EMULATOR 1
+
+#define IS_VALID_STR_PTR(p) ((p) != NULL)
+
+#define TEX_RES 1
+
+#define _NUM_CACHE (4096 / (TEX_WIDTH * TEX_HEIGHT * (TEX_BITDEPTH / 8)))
@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+"""
+Tools for ordering the game's functions by how often they run, so that the
+functions that run every frame sit next to each other in the VR4300's
+direct mapped instruction cache instead of evicting each other.
+
+  profile   Turn a PC trace into a call frequency profile.
+  ld        Turn a profile into a linker script fragment, see FUNCTION_ORDER in the Makefile.
+  simulate  Compare instruction cache hit rates of two layouts for the same PC trace.
+
+A PC trace is a text file with one hexadecimal program counter per line, as
+recorded by an emulator's trace logger. A profile is a text file with one
+"<count> <function> [<object>]" entry per line; lines starting with # are
+ignored, and a line with only a function name counts as 1. The object, such as
+src/game/foo.o, tells apart static functions with the same name. profile writes
+it for those, and ld orders every function of that name when it is left out.
+"""
+
+import argparse
+import bisect
+import re
+import sys
+
+# VR4300 instruction cache
+ICACHE_SIZE = 0x4000
+ICACHE_LINE_SIZE = 0x20
+
+# Only functions from these folders are linked into the engine segment,
+# so only they can be moved next to each other.
+ORDERABLE_PREFIXES = ("src/game/", "src/engine/")
+
+SECTION_RE = re.compile(r"^ \.text\.(\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+))?\s*$")
+SECTION_CONT_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+)\s*$")
+
+
+class MapFunction:
+    def __init__(self, name, addr, size, obj):
+        self.name = name
+        self.addr = addr
+        self.size = size
+        self.obj = obj
+
+
+def read_map(path):
+    """
+    Read the .text.<function> input sections from a linker map, which exist
+    because the game is built with -ffunction-sections.
+    Long section names put the address, size and file on the following line.
+    Returns the functions by name, as lists since static functions can share a name.
+    """
+    functions = {}
+    pending = None
+
+    with open(path) as f:
+        for line in f:
+            if pending is not None:
+                match = SECTION_CONT_RE.match(line)
+                if match:
+                    add_map_function(functions, pending, match.group(1), match.group(2), match.group(3))
+                pending = None
+                continue
+
+            match = SECTION_RE.match(line)
+            if match is None:
+                continue
+            if match.group(2) is None:
+                pending = match.group(1)
+            else:
+                add_map_function(functions, match.group(1), match.group(2), match.group(3), match.group(4))
+
+    return functions
+
+
+def add_map_function(functions, name, addr, size, obj):
+    addr = int(addr, 16) & 0xFFFFFFFF
+    size = int(size, 16)
+    # Sections that were garbage collected or are empty have no address.
+    if addr == 0 or size == 0:
+        return
+    functions.setdefault(name, []).append(MapFunction(name, addr, size, obj))
+
+
+def find_map_function(functions, name, obj):
+    """ The function with the given name from the given object, which can be None if the name is unique. """
+    candidates = functions.get(name, [])
+    if obj is None:
+        return candidates[0] if len(candidates) == 1 else None
+    for func in candidates:
+        if object_path(func.obj) == obj or func.obj == obj:
+            return func
+    return None
+
+
+def read_profile(path):
+    counts = {}
+
+    with open(path) as f:
+        for line in f:
+            tokens = line.split()
+            if len(tokens) == 0 or tokens[0].startswith("#"):
+                continue
+            if len(tokens) == 1:
+                key = (tokens[0], None)
+                counts[key] = counts.get(key, 0) + 1
+            else:
+                key = (tokens[1], tokens[2] if len(tokens) > 2 else None)
+                counts[key] = counts.get(key, 0) + int(tokens[0])
+
+    return counts
+
+
+def read_trace(path):
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if len(line) != 0 and not line.startswith("#"):
+                yield int(line, 16) & 0xFFFFFFFF
+
+
+class AddressLookup:
+    def __init__(self, functions):
+        self.functions = sorted((func for funcs in functions.values() for func in funcs), key=lambda func: func.addr)
+        self.starts = [func.addr for func in self.functions]
+
+    def find(self, pc):
+        i = bisect.bisect_right(self.starts, pc) - 1
+        if i >= 0:
+            func = self.functions[i]
+            if pc < (func.addr + func.size):
+                return func
+        return None
+
+
+def object_path(obj):
+    # build/us_n64/src/game/foo.o -> src/game/foo.o
+    for prefix in ORDERABLE_PREFIXES:
+        i = obj.find(prefix)
+        if i >= 0:
+            return obj[i:]
+    return None
+
+
+def cmd_profile(args):
+    functions = read_map(args.map)
+    lookup = AddressLookup(functions)
+    counts = {}
+
+    for pc in read_trace(args.trace):
+        func = lookup.find(pc)
+        if func is not None:
+            counts[func] = counts.get(func, 0) + 1
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    for func, count in sorted(counts.items(), key=lambda item: (-item[1], item[0].name, item[0].obj)):
+        if len(functions[func.name]) > 1:
+            out.write("%d %s %s\n" % (count, func.name, object_path(func.obj) or func.obj))
+        else:
+            out.write("%d %s\n" % (count, func.name))
+
+
+def cmd_ld(args):
+    functions = read_map(args.map)
+    counts = read_profile(args.profile)
+    placed = set()
+    total = 0
+    full = False
+
+    with open(args.output, "w") as out:
+        out.write("/* Generated by tools/function_order.py from %s, do not edit. */\n" % args.profile)
+        for (name, obj), count in sorted(counts.items(), key=lambda item: (-item[1], item[0][0], item[0][1] or "")):
+            if count < args.min_count:
+                continue
+            func = find_map_function(functions, name, obj)
+            if func is not None:
+                funcs = [func]
+            elif obj is None:
+                # A static name without an object, order every function that has it.
+                funcs = functions.get(name, [])
+            else:
+                funcs = []
+            for func in funcs:
+                path = object_path(func.obj)
+                if path is None or func in placed:
+                    continue
+                if args.limit and (total + func.size) > args.limit:
+                    full = True
+                    break
+                out.write("      BUILD_DIR/%s(.text.%s);\n" % (path, name))
+                placed.add(func)
+                total += func.size
+            if full:
+                break
+
+    print("Ordered 0x%X bytes of hot functions" % total)
+
+
+def simulate_icache(pcs):
+    lines = [None] * (ICACHE_SIZE // ICACHE_LINE_SIZE)
+    hits = 0
+    total = 0
+
+    for pc in pcs:
+        line = pc // ICACHE_LINE_SIZE
+        index = line % len(lines)
+        if lines[index] == line:
+            hits += 1
+        else:
+            lines[index] = line
+        total += 1
+
+    return hits, total
+
+
+def cmd_simulate(args):
+    old_functions = read_map(args.old_map)
+    new_functions = read_map(args.new_map)
+    lookup = AddressLookup(old_functions)
+
+    def relocate(pcs):
+        for pc in pcs:
+            func = lookup.find(pc)
+            moved = None if func is None else find_map_function(new_functions, func.name, object_path(func.obj) or func.obj)
+            if moved is not None:
+                pc = moved.addr + (pc - func.addr)
+            yield pc
+
+    old_hits, total = simulate_icache(read_trace(args.trace))
+    new_hits, _ = simulate_icache(relocate(read_trace(args.trace)))
+
+    if total == 0:
+        print("Empty trace")
+        return
+
+    print("Instructions: %d" % total)
+    print("Old layout: %.3f%% hits, %d misses" % (100.0 * old_hits / total, total - old_hits))
+    print("New layout: %.3f%% hits, %d misses" % (100.0 * new_hits / total, total - new_hits))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Order functions by call frequency for instruction cache locality.")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("profile", help="count how often each function appears in a PC trace")
+    p.add_argument("map", help="linker map of the build the trace was recorded on")
+    p.add_argument("trace", help="PC trace, one hexadecimal address per line")
+    p.add_argument("-o", "--output", help="profile to write, defaults to stdout")
+    p.set_defaults(func=cmd_profile)
+
+    p = sub.add_parser("ld", help="write the hot functions of a profile as linker script input sections")
+    p.add_argument("map", help="linker map to read function sizes and object files from")
+    p.add_argument("profile", help="call frequency profile")
+    p.add_argument("output", help="linker script fragment to write")
+    p.add_argument("--limit", type=lambda x: int(x, 0), default=0, help="stop after this many bytes of functions")
+    p.add_argument("--min-count", type=int, default=1, help="skip functions seen fewer times than this")
+    p.set_defaults(func=cmd_ld)
+
+    p = sub.add_parser("simulate", help="compare instruction cache hit rates of two layouts")
+    p.add_argument("old_map", help="linker map of the build the trace was recorded on")
+    p.add_argument("new_map", help="linker map of the reordered build")
+    p.add_argument("trace", help="PC trace, one hexadecimal address per line")
+    p.set_defaults(func=cmd_simulate)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
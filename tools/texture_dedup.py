@@ -0,0 +1,451 @@
+#!/usr/bin/env python3
+"""
+Finds textures that are stored more than once across the levels and actor
+groups, and moves them into a shared bank in segment 2, which is loaded once
+at boot and stays resident. The levels and actor groups then no longer DMA
+and decompress their own copy every time they are loaded.
+
+  report  List the duplicated textures and how many bytes they waste.
+  apply   Move textures used by at least --min-users segments into bin/shared_textures.inc.c
+          and turn their old definitions into aliases of the shared copy.
+  check   Make sure every alias and every display list that uses one refers to a texture in the
+          shared bank, then, from a build, that the bank is linked into segment 2 and every alias
+          resolves to byte identical texture data.
+
+Only single file texture definitions that are static to their level or actor
+group are moved, since other files can't refer to them by name. A display list
+load that reads more bytes than its texture holds also fills TMEM with the
+textures after it in the segment, so those textures stay where they are.
+Textures that are only loaded from C code should be skipped with --exclude.
+
+Every shared texture is kept in RAM for the whole game, since segment 2 is
+never unloaded. apply writes the size of the bank into its header.
+
+apply edits the source tree, use git to undo it.
+
+The textures are compared through their PNGs, which an extracted tree only has after the
+assets are extracted from a ROM, so report and apply find nothing without them. The tool has
+not been run against a tree with the extracted assets yet, so run check on a build after apply.
+"""
+
+import argparse
+import glob
+import hashlib
+import os
+import re
+import struct
+import sys
+
+BANK_PATH = "bin/shared_textures.inc.c"
+BANK_HEADER = (
+    "// Generated by tools/texture_dedup.py, do not edit.\n"
+    "// Textures used by more than one level or actor group, kept resident in segment 2.\n"
+)
+BANK_SIZE_COMMENT = "// Keeps %d bytes of RAM in use for the whole game.\n"
+ALIAS_COMMENT = "// Moved to the shared texture bank in segment 2, see tools/texture_dedup.py.\n"
+
+# Bits per pixel of each format that tools/n64graphics converts.
+FORMAT_BPP = {
+    "rgba32": 32,
+    "rgba16": 16,
+    "ia16": 16,
+    "ia8": 8,
+    "ia4": 4,
+    "ia1": 1,
+    "i8": 8,
+    "i4": 4,
+}
+
+TEXTURE_RE = re.compile(
+    r'^ALIGNED8 static const Texture (\w+)\[\] = \{\n#include "([^"]+)\.inc\.c"\n\};\n', re.MULTILINE
+)
+ALIAS_RE = re.compile(
+    r'^// (\S+)\.inc\.c\nextern const Texture (\w+)\[\];\n#define (\w+) (\w+)\n', re.MULTILINE
+)
+BANK_RE = re.compile(r'^ALIGNED8 const Texture (\w+)\[\] = \{\n#include "([^"]+)\.inc\.c"\n\};\n', re.MULTILINE)
+# Any texture definition, used to find which textures are next to each other in a segment.
+ANY_TEXTURE_RE = re.compile(
+    r'^ALIGNED8 (?:static )?const Texture (\w+)\[\] = \{\n((?:#include "[^"]+"\n)+)\};\n', re.MULTILINE
+)
+INCLUDE_RE = re.compile(r'^#include "([^"]+\.c)"', re.MULTILINE)
+LOAD_RE = re.compile(
+    r'gsDPSetTextureImage\(\s*\w+,\s*(?P<img_siz>\w+),\s*[^,]+,\s*(?P<img>\w+)\s*\)'
+    r'|gsDPLoadBlock\(\s*[^,]+,\s*[^,]+,\s*[^,]+,\s*(?P<lrs>[^,]+),'
+    r'|gsDPLoadTile\('
+    r'|gsDPLoadTextureBlock\(\s*(?P<block>\w+),\s*\w+,\s*(?P<block_siz>\w+),\s*(?P<block_w>[^,]+),\s*(?P<block_h>[^,]+),'
+    r'|gsDPLoadTextureBlock_4b\(\s*(?P<block4>\w+),\s*\w+,\s*(?P<block4_w>[^,]+),\s*(?P<block4_h>[^,]+),'
+)
+INCLUDE_LINE_RE = re.compile(r'^#include "([^"]+\.c)"\n', re.MULTILINE)
+MAP_SYMBOL_RE = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+(\w+)$', re.MULTILINE)
+NUMBER_EXPR_RE = re.compile(r'^[0-9xXa-fA-F\s()*+\-/<>]+$')
+
+SIZ_BITS = {
+    "G_IM_SIZ_4b": 4,
+    "G_IM_SIZ_8b": 8,
+    "G_IM_SIZ_16b": 16,
+    "G_IM_SIZ_32b": 32,
+}
+
+
+class TextureLoad:
+    def __init__(self, segment, name, size):
+        self.segment = segment
+        self.name = name
+        self.size = size  # Bytes read from the texture onwards, None if unknown
+
+
+class TextureDef:
+    def __init__(self, name, path, source, segment, start, end):
+        self.name = name
+        self.path = path  # Texture path without extension, e.g. levels/bob/0.rgba16
+        self.source = source
+        self.segment = segment
+        self.start = start
+        self.end = end
+
+
+def png_size(path):
+    with open(path, "rb") as f:
+        header = f.read(24)
+    if len(header) < 24 or header[:8] != b"\x89PNG\r\n\x1a\n":
+        return None
+    return struct.unpack(">II", header[16:24])
+
+
+def texture_format(path):
+    return path.rsplit(".", 1)[-1]
+
+
+def texture_bytes(path):
+    size = png_size(path + ".png")
+    if size is None:
+        return 0
+    return (size[0] * size[1] * FORMAT_BPP[texture_format(path)]) // 8
+
+
+def texture_hash(path):
+    # Converting the same image to another format gives different data.
+    with open(path + ".png", "rb") as f:
+        return hashlib.sha1(texture_format(path).encode() + f.read()).hexdigest()
+
+
+def segments():
+    """ Map each level and actor group to its source files, in the order they are linked. """
+    roots = sorted(glob.glob("levels/*/leveldata.c")) + sorted(glob.glob("actors/*.c"))
+    return {os.path.dirname(root) if root.startswith("levels/") else os.path.splitext(root)[0]:
+            segment_sources(root, []) for root in roots}
+
+
+def segment_sources(source, sources):
+    sources.append(source)
+    with open(source) as f:
+        text = f.read()
+    for include in INCLUDE_RE.findall(text):
+        for path in (os.path.join(os.path.dirname(source), include), include):
+            if os.path.exists(path):
+                if path not in sources:
+                    segment_sources(path, sources)
+                break
+    return sources
+
+
+def expand_source(source, seen):
+    """ The text of a source file with the source files it includes pasted in, as the compiler sees it. """
+    seen.add(source)
+    with open(source) as f:
+        text = f.read()
+
+    def paste(match):
+        for path in (os.path.join(os.path.dirname(source), match.group(1)), match.group(1)):
+            if os.path.exists(path):
+                return "" if path in seen else expand_source(path, seen)
+        return match.group(0)
+
+    return INCLUDE_LINE_RE.sub(paste, text)
+
+
+def eval_size(expr):
+    expr = expr.strip()
+    if not NUMBER_EXPR_RE.match(expr):
+        return None
+    try:
+        return int(eval(expr, {"__builtins__": {}}))
+    except (SyntaxError, NameError, TypeError, ZeroDivisionError):
+        return None
+
+
+def find_loads(segment, text):
+    """ Find how many bytes each display list load reads, starting from the texture it names. """
+    loads = []
+    image = None
+
+    for match in LOAD_RE.finditer(text):
+        if match.group("img"):
+            image = (match.group("img"), SIZ_BITS.get(match.group("img_siz")))
+        elif match.group("block"):
+            w, h = eval_size(match.group("block_w")), eval_size(match.group("block_h"))
+            bits = SIZ_BITS.get(match.group("block_siz"))
+            size = None if w is None or h is None or bits is None else (w * h * bits) // 8
+            loads.append(TextureLoad(segment, match.group("block"), size))
+        elif match.group("block4"):
+            w, h = eval_size(match.group("block4_w")), eval_size(match.group("block4_h"))
+            size = None if w is None or h is None else (w * h) // 2
+            loads.append(TextureLoad(segment, match.group("block4"), size))
+        elif image is not None:
+            # Tile loads can't be sized without following the tile setup, so they count as unknown.
+            lrs = eval_size(match.group("lrs")) if match.group("lrs") else None
+            size = None if lrs is None or image[1] is None else ((lrs + 1) * image[1]) // 8
+            loads.append(TextureLoad(segment, image[0], size))
+            image = None
+
+    return loads
+
+
+def find_tmem_dependencies(ordered, loads):
+    """
+    Find the textures that a load reads past the end of its own texture into, along with the
+    texture it names. Unknown load sizes and textures of unknown size count as reaching the next one.
+    """
+    pinned = set()
+    index = {}
+    for i, (segment, name, size) in enumerate(ordered):
+        index[(segment, name)] = i
+
+    for load in loads:
+        i = index.get((load.segment, load.name))
+        if i is None:
+            continue
+        extra = None if load.size is None or ordered[i][2] is None else load.size - ordered[i][2]
+        if extra is not None and extra <= 0:
+            continue
+        pinned.add((load.segment, load.name))
+        for segment, name, size in ordered[i + 1:]:
+            if segment != load.segment:
+                break
+            pinned.add((segment, name))
+            if extra is None or size is None:
+                break
+            extra -= size
+            if extra <= 0:
+                break
+
+    return pinned
+
+
+def definition_size(includes):
+    size = 0
+    for path in re.findall(r'#include "([^"]+)\.inc\.c"', includes):
+        if texture_format(path) not in FORMAT_BPP or not os.path.exists(path + ".png"):
+            return None
+        size += texture_bytes(path)
+    return size
+
+
+def find_textures(excluded):
+    textures = []
+    ordered = []
+    loads = []
+
+    for segment, sources in segments().items():
+        for source in sources:
+            with open(source) as f:
+                text = f.read()
+            for match in ANY_TEXTURE_RE.finditer(text):
+                ordered.append((segment, match.group(1), definition_size(match.group(2))))
+            loads += find_loads(segment, text)
+            for match in TEXTURE_RE.finditer(text):
+                name, path = match.group(1), match.group(2)
+                if name in excluded or texture_format(path) not in FORMAT_BPP or not os.path.exists(path + ".png"):
+                    continue
+                textures.append(TextureDef(name, path, source, segment, match.start(), match.end()))
+
+    pinned = find_tmem_dependencies(ordered, loads)
+    return [texture for texture in textures if (texture.segment, texture.name) not in pinned], pinned
+
+
+def find_duplicates(textures, min_users):
+    by_hash = {}
+    for texture in textures:
+        by_hash.setdefault(texture_hash(texture.path), []).append(texture)
+
+    duplicates = []
+    for digest, group in by_hash.items():
+        segments = set(texture.segment for texture in group)
+        if len(segments) >= min_users:
+            duplicates.append((digest, group, segments))
+
+    duplicates.sort(key=lambda dup: (-texture_bytes(dup[1][0].path) * (len(dup[1]) - 1), dup[1][0].path))
+    return duplicates
+
+
+def cmd_report(args):
+    textures, pinned = find_textures(set(args.exclude))
+    duplicates = find_duplicates(textures, args.min_users)
+    wasted = 0
+    shared = 0
+
+    for digest, group, segments in duplicates:
+        size = texture_bytes(group[0].path)
+        wasted += size * (len(group) - 1)
+        shared += size
+        if args.verbose:
+            print("%6d bytes x%d  %s" % (size, len(group), ", ".join(sorted(segments))))
+            for texture in group:
+                print("        %s (%s)" % (texture.name, texture.path))
+
+    if args.verbose:
+        for segment, name in sorted(pinned):
+            print("Loaded together with its neighbours, left in place: %s (%s)" % (name, segment))
+
+    total = sum(texture_bytes(texture.path) for texture in textures)
+    print("Textures: %d, %d bytes" % (len(textures), total))
+    print("Left in place for loads that span several textures: %d" % len(pinned))
+    print("Used by %d or more segments: %d, %d bytes" % (args.min_users, len(duplicates), shared))
+    print("Duplicated bytes: %d" % wasted)
+
+
+def cmd_apply(args):
+    textures, pinned = find_textures(set(args.exclude))
+    duplicates = find_duplicates(textures, args.min_users)
+    edits = {}
+
+    with open(BANK_PATH) as f:
+        bank = f.read()
+    # Drop the header, it's rewritten with the new size below.
+    bank = bank[bank.index("\nALIGNED8"):] if "\nALIGNED8" in bank else ""
+
+    for digest, group, segments in duplicates:
+        shared_name = "shared_texture_" + digest[:8]
+        bank += '\nALIGNED8 const Texture %s[] = {\n#include "%s.inc.c"\n};\n' % (shared_name, group[0].path)
+        for texture in group:
+            edits.setdefault(texture.source, []).append((texture, shared_name))
+
+    for source, source_edits in edits.items():
+        with open(source) as f:
+            text = f.read()
+        # Edit from the end so the earlier offsets stay valid.
+        for texture, shared_name in sorted(source_edits, key=lambda edit: -edit[0].start):
+            alias = ALIAS_COMMENT + "// %s.inc.c\nextern const Texture %s[];\n#define %s %s\n" % (
+                texture.path, shared_name, texture.name, shared_name)
+            text = text[:texture.start] + alias + text[texture.end:]
+        with open(source, "w") as f:
+            f.write(text)
+
+    resident = sum(texture_bytes(path) for name, path in BANK_RE.findall(bank))
+    with open(BANK_PATH, "w") as f:
+        f.write(BANK_HEADER + BANK_SIZE_COMMENT % resident + bank)
+
+    print("Moved %d textures into %s, replacing %d definitions in %d files" % (
+        len(duplicates), BANK_PATH, sum(len(e) for e in edits.values()), len(edits)))
+    print("The bank keeps %d bytes resident in segment 2" % resident)
+
+
+def read_file(path):
+    try:
+        with open(path, "rb") as f:
+            return f.read()
+    except OSError:
+        return None
+
+
+def check_references(bank):
+    """
+    Check that each level and actor group, as the compiler sees it, only uses its aliased
+    textures after their alias, and no longer defines them itself. Returns the aliases found
+    as (segment, texture path, shared name, name) and the problems found.
+    """
+    aliases = []
+    problems = []
+
+    with open("bin/segment2.c") as f:
+        if '#include "%s"' % BANK_PATH not in f.read():
+            problems.append("bin/segment2.c doesn't include %s" % BANK_PATH)
+
+    for segment, sources in segments().items():
+        text = expand_source(sources[0], set())
+        defined = set(match.group(1) for match in ANY_TEXTURE_RE.finditer(text))
+
+        for match in ALIAS_RE.finditer(text):
+            path, shared_name, name, target = match.groups()
+            aliases.append((segment, path, shared_name, name))
+            if shared_name != target or shared_name not in bank:
+                problems.append("%s: %s doesn't refer to a texture in the shared bank" % (segment, name))
+            if name in defined:
+                problems.append("%s: %s is still defined next to its alias" % (segment, name))
+            if re.search(r'\b%s\b' % name, text[:match.start()]):
+                problems.append("%s: %s is used before its alias" % (segment, name))
+
+        # Display lists that name a shared texture directly skip the alias, which is fine,
+        # as long as the texture is in the bank.
+        for load in find_loads(segment, text):
+            if load.name.startswith("shared_texture_") and load.name not in bank:
+                problems.append("%s: a display list loads %s, which isn't in the shared bank" % (segment, load.name))
+
+    return aliases, problems
+
+
+def check_build(build_dir, bank, aliases):
+    """ Check that the bank is linked into segment 2, and that each alias has the same data as its shared texture. """
+    problems = []
+
+    segment2_map = read_file(os.path.join(build_dir, "bin/segment2.elf.map"))
+    if segment2_map is None:
+        problems.append("%s hasn't been linked in %s" % ("bin/segment2.elf", build_dir))
+    else:
+        symbols = dict((name, int(address, 16)) for address, name in MAP_SYMBOL_RE.findall(segment2_map.decode()))
+        for shared_name in sorted(bank):
+            if (symbols.get(shared_name, 0) >> 24) != 0x02:
+                problems.append("%s isn't linked into segment 2" % shared_name)
+
+    for segment, path, shared_name, name in aliases:
+        if shared_name not in bank:
+            continue
+        original = read_file(os.path.join(build_dir, path + ".inc.c"))
+        shared = read_file(os.path.join(build_dir, bank[shared_name] + ".inc.c"))
+        if original is None or shared is None:
+            problems.append("%s: %s hasn't been converted in %s" % (segment, name, build_dir))
+        elif original != shared:
+            problems.append("%s: %s differs from %s" % (segment, name, shared_name))
+
+    return problems
+
+
+def cmd_check(args):
+    with open(BANK_PATH) as f:
+        bank = dict(BANK_RE.findall(f.read()))
+
+    aliases, problems = check_references(bank)
+    problems += check_build(args.build_dir, bank, aliases)
+
+    for problem in problems:
+        print(problem)
+    print("Checked %d aliases of %d shared textures, %d problems" % (len(aliases), len(bank), len(problems)))
+    if problems:
+        sys.exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Share textures that are duplicated across levels and actor groups.")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("report", help="list duplicated textures")
+    p.add_argument("-v", "--verbose", action="store_true", help="list every duplicated texture")
+    p.set_defaults(func=cmd_report)
+
+    p = sub.add_parser("apply", help="move duplicated textures into the shared bank")
+    p.set_defaults(func=cmd_apply)
+
+    for p in sub.choices.values():
+        p.add_argument("--min-users", type=int, default=2, help="only share textures used by this many segments")
+        p.add_argument("--exclude", action="append", default=[], help="texture symbol to leave where it is")
+
+    p = sub.add_parser("check", help="check the aliases, the display lists using them, and a build's converted textures")
+    p.add_argument("build_dir", help="build folder, e.g. build/us_n64")
+    p.set_defaults(func=cmd_check)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()